@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+#ifndef OPVIEW_BENCH_BENCH_HPP_
+#define OPVIEW_BENCH_BENCH_HPP_
+
+// Minimal benchmark helpers (no external library):
+// run(name, ops, f) calls f() a few times, and prints the best time per
+// operation (in nanoseconds), so results are not dominated by noise.
+// Hardware counters (e.g., branch or cache misses) can be read by running
+// a benchmark under 'perf stat'.
+
+#include <chrono>    // for std::chrono::steady_clock
+#include <cstddef>   // for std::size_t
+#include <cstdio>    // for std::printf
+#include <cstdint>   // for std::uint64_t
+#include <limits>    // for std::numeric_limits
+#include <random>    // for std::mt19937_64
+
+namespace bench {
+
+// keeps value alive, so that the optimizer cannot drop its computation
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+// fixed seed: every run sees the same inputs
+inline std::mt19937_64& rng() {
+  static std::mt19937_64 engine{42};
+  return engine;
+}
+
+inline constexpr int repetitions = 5;
+
+template <typename F>
+double run(const char* name, std::size_t ops, F&& f) {
+  double best = std::numeric_limits<double>::max();
+  for (int r = 0; r < repetitions; ++r) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    if (ns < best) best = ns;
+  }
+  double per_op = best / static_cast<double>(ops);
+  std::printf("%-44s %8.3f ns/op\n", name, per_op);
+  return per_op;
+}
+
+}  // namespace bench
+
+#endif  // OPVIEW_BENCH_BENCH_HPP_
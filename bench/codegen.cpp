@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+// codegen check (not timed): with unchecked_access (the default), *ov and
+// ov->member must compile to the same instructions as a raw pointer.
+// `make codegen` compiles this file to assembly at -O2 and diffs the
+// bodies of each view_* function against its ptr_* counterpart.
+
+#include <opview/optional_view.hpp>
+
+#include <utility>
+
+using view = opview::optional_view<int, opview::unchecked_access>;
+using pair_view =
+    opview::optional_view<std::pair<int, int>, opview::unchecked_access>;
+
+extern "C" {
+
+int view_deref(view ov) { return *ov; }
+
+int ptr_deref(int* p) { return *p; }
+
+int view_arrow(pair_view ov) { return ov->second; }
+
+int ptr_arrow(std::pair<int, int>* p) { return p->second; }
+
+void view_store(view ov, int v) { *ov = v; }
+
+void ptr_store(int* p, int v) { *p = v; }
+}
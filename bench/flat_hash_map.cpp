@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+// flat_hash_map::find_view vs std::unordered_map::find (+ compare to end)
+// Lookups of random keys (half hits, half misses), for int and string
+// keys, on small and large tables. Both maps get the same (prebuilt) query
+// keys; for strings, flat_hash_map is also timed with heterogeneous
+// lookup (std::string_view queries, no std::string needed).
+
+#include <opview/flat_hash_map.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "bench.hpp"
+
+struct string_hash {
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view s) const noexcept {
+    return std::hash<std::string_view>{}(s);
+  }
+};
+
+constexpr std::size_t kLookups = 1 << 20;
+
+void run_int(std::size_t size) {
+  std::unordered_map<int, int> std_map;
+  opview::flat_hash_map<int, int> flat_map;
+  std::uniform_int_distribution<int> key{0, static_cast<int>(2 * size)};
+  while (std_map.size() < size) {
+    int k = key(bench::rng());
+    std_map[k] = k;
+    flat_map[k] = k;
+  }
+  std::vector<int> queries(kLookups);
+  for (int& q : queries) q = key(bench::rng());
+
+  std::printf("-- int keys, %zu entries\n", size);
+  bench::run("std::unordered_map::find", kLookups, [&] {
+    long long sum = 0;
+    for (int q : queries) {
+      auto it = std_map.find(q);
+      sum += it != std_map.end() ? it->second : 0;
+    }
+    bench::do_not_optimize(sum);
+  });
+  bench::run("flat_hash_map::find_view", kLookups, [&] {
+    long long sum = 0;
+    for (int q : queries) sum += flat_map.find_view(q).value_or(0);
+    bench::do_not_optimize(sum);
+  });
+}
+
+void run_string(std::size_t size) {
+  std::unordered_map<std::string, int> std_map;
+  opview::flat_hash_map<std::string, int, string_hash, std::equal_to<>>
+      flat_map;
+  std::uniform_int_distribution<std::size_t> key{0, 2 * size};
+  auto make_key = [](std::size_t k) {
+    return "header-name-" + std::to_string(k);
+  };
+  while (std_map.size() < size) {
+    std::string k = make_key(key(bench::rng()));
+    std_map[k] = 1;
+    flat_map[k] = 1;
+  }
+  std::vector<std::string> queries(kLookups);
+  for (auto& q : queries) q = make_key(key(bench::rng()));
+  std::vector<std::string_view> views(queries.begin(), queries.end());
+
+  std::printf("-- string keys, %zu entries\n", size);
+  bench::run("std::unordered_map::find", kLookups, [&] {
+    long long sum = 0;
+    for (const std::string& q : queries) {
+      auto it = std_map.find(q);
+      sum += it != std_map.end() ? it->second : 0;
+    }
+    bench::do_not_optimize(sum);
+  });
+  bench::run("flat_hash_map::find_view", kLookups, [&] {
+    long long sum = 0;
+    for (const std::string& q : queries)
+      sum += flat_map.find_view(q).value_or(0);
+    bench::do_not_optimize(sum);
+  });
+  bench::run("flat_hash_map::find_view (string_view)", kLookups, [&] {
+    long long sum = 0;
+    for (std::string_view q : views) sum += flat_map.find_view(q).value_or(0);
+    bench::do_not_optimize(sum);
+  });
+}
+
+int main() {
+  run_int(1 << 10);
+  run_int(1 << 20);
+  run_string(1 << 10);
+  run_string(1 << 18);
+  return 0;
+}
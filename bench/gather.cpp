@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+// gather_or: hardware masked gathers (AVX2, AVX-512F) vs branchless scalar
+// Views point to random positions of a value array (20% empty), either
+// cache-resident or much larger than last-level cache. Each kernel is
+// called directly (no runtime dispatch), so all paths are compared on the
+// same machine; gather_or() itself uses whatever detect_gather_isa() picks.
+
+// hardware gathers are opt-in
+#define OPVIEW_GATHER_SIMD 1
+
+#include <opview/gather.hpp>
+#include <opview/storable_optional_view.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+
+using opview::storable_optional_view;
+
+constexpr std::size_t kViews = 1 << 16;
+
+template <typename U>
+void run_case(const char* title, std::size_t num_values) {
+  std::vector<U> values(num_values);
+  for (std::size_t i = 0; i < num_values; ++i)
+    values[i] = static_cast<U>(i % 1000);
+  std::uniform_int_distribution<std::size_t> pick{0, num_values - 1};
+  std::bernoulli_distribution engaged{0.8};
+  std::vector<storable_optional_view<U>> views;
+  views.reserve(kViews);
+  for (std::size_t i = 0; i < kViews; ++i) {
+    if (engaged(bench::rng()))
+      views.push_back(values[pick(bench::rng())]);
+    else
+      views.push_back(std::nullopt);
+  }
+  std::vector<U> out(kViews);
+  const U dflt = static_cast<U>(-1);
+  int rounds = num_values > kViews ? 20 : 200;
+  std::size_t ops = kViews * rounds;
+
+  std::printf("-- %s\n", title);
+  bench::run("scalar (branchless)", ops, [&] {
+    for (int r = 0; r < rounds; ++r) {
+      opview::detail::gather_or_scalar(views.data(), kViews, dflt,
+                                       out.data());
+      bench::do_not_optimize(out[r]);
+    }
+  });
+#ifdef OPVIEW_GATHER_X86
+  using opview::detail::gather_isa;
+  gather_isa isa = opview::detail::detect_gather_isa();
+  if (isa == gather_isa::avx2 || isa == gather_isa::avx512) {
+    bench::run("avx2 masked gather", ops, [&] {
+      for (int r = 0; r < rounds; ++r) {
+        if constexpr (sizeof(U) == 8) {
+          std::int64_t bits = 0;
+          std::memcpy(&bits, &dflt, sizeof(U));
+          opview::detail::gather64_avx2(views.data(), kViews, bits,
+                                        out.data());
+        } else {
+          std::int32_t bits = 0;
+          std::memcpy(&bits, &dflt, sizeof(U));
+          opview::detail::gather32_avx2(views.data(), kViews, bits,
+                                        out.data());
+        }
+        bench::do_not_optimize(out[r]);
+      }
+    });
+  }
+  if (isa == gather_isa::avx512) {
+    bench::run("avx512f masked gather", ops, [&] {
+      for (int r = 0; r < rounds; ++r) {
+        if constexpr (sizeof(U) == 8) {
+          std::int64_t bits = 0;
+          std::memcpy(&bits, &dflt, sizeof(U));
+          opview::detail::gather64_avx512(views.data(), kViews, bits,
+                                          out.data());
+        } else {
+          std::int32_t bits = 0;
+          std::memcpy(&bits, &dflt, sizeof(U));
+          opview::detail::gather32_avx512(views.data(), kViews, bits,
+                                          out.data());
+        }
+        bench::do_not_optimize(out[r]);
+      }
+    });
+  }
+#endif
+  bench::run("gather_or (dispatched)", ops, [&] {
+    for (int r = 0; r < rounds; ++r) {
+      opview::gather_or(views, dflt, out.data());
+      bench::do_not_optimize(out[r]);
+    }
+  });
+}
+
+int main() {
+  constexpr std::size_t kSmall = 1 << 14;  // cache-resident
+  constexpr std::size_t kLarge = 1 << 25;  // far beyond last-level cache
+  run_case<int>("int, cache-resident", kSmall);
+  run_case<int>("int, large working set", kLarge);
+  run_case<double>("double, cache-resident", kSmall);
+  run_case<double>("double, large working set", kLarge);
+  return 0;
+}
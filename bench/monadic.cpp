@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+// optional_view monadics vs std::optional monadics (C++23)
+// Chain: config -> optional server -> timeout (or 0).
+// std::optional::and_then must return an optional by value, so each step
+// copies the nested object, while optional_view chains only propagate a
+// pointer (no copies of T). When the copy is trivial and fully inlined,
+// the optimizer may drop it (and std::optional can even win, as its
+// storage is always loadable, so no branch is needed); when T owns
+// resources (here, a std::vector), the copy cannot be dropped.
+
+#include <opview/optional_view.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "bench.hpp"
+
+#if !defined(__cpp_lib_optional) || __cpp_lib_optional < 202110L
+int main() {
+  std::printf("std::optional monadics need C++23 (skipped)\n");
+  return 0;
+}
+#else
+
+using opview::optional_view;
+
+struct Limits {
+  int max_connections;
+  int timeout;
+};
+
+// trivially copyable
+struct FlatServer {
+  std::array<int, 64> stats;
+  Limits limits;
+};
+
+// owns memory: copies allocate
+struct HeapServer {
+  std::vector<int> stats;
+  Limits limits;
+};
+
+template <typename Server>
+struct Config {
+  std::array<int, 16> header;
+  std::optional<Server> server;
+};
+
+constexpr std::size_t kSize = 1 << 14;
+constexpr int kRounds = 50;
+
+template <typename Server>
+__attribute__((noinline)) long long sum_pointers(
+    std::vector<std::optional<Config<Server>>>& configs) {
+  long long sum = 0;
+  for (auto& c : configs) {
+    const Server* s = c && c->server ? &*c->server : nullptr;
+    sum += s ? s->limits.timeout : 0;
+  }
+  return sum;
+}
+
+template <typename Server>
+__attribute__((noinline)) long long sum_optional_view(
+    std::vector<std::optional<Config<Server>>>& configs) {
+  long long sum = 0;
+  for (auto& c : configs) {
+    sum += optional_view<Config<Server>>{c}
+               .and_then([](Config<Server>& cfg) {
+                 return optional_view<Server>{cfg.server};
+               })
+               .transform([](Server& s) -> int& { return s.limits.timeout; })
+               .value_or(0);
+  }
+  return sum;
+}
+
+template <typename Server>
+__attribute__((noinline)) long long sum_std_optional(
+    std::vector<std::optional<Config<Server>>>& configs) {
+  long long sum = 0;
+  for (auto& c : configs) {
+    sum += c.and_then([](const Config<Server>& cfg) { return cfg.server; })
+               .transform([](const Server& s) { return s.limits.timeout; })
+               .value_or(0);
+  }
+  return sum;
+}
+
+template <typename Server>
+int run_all(const char* title) {
+  std::bernoulli_distribution present{0.8};
+  std::vector<std::optional<Config<Server>>> configs(kSize);
+  for (std::size_t i = 0; i < kSize; ++i) {
+    if (!present(bench::rng())) continue;
+    configs[i].emplace();
+    if (present(bench::rng())) {
+      configs[i]->server.emplace();
+      if constexpr (!std::is_trivially_copyable<Server>::value)
+        configs[i]->server->stats.resize(64);
+      configs[i]->server->limits = {100, static_cast<int>(i % 60)};
+    }
+  }
+  if (sum_optional_view(configs) != sum_std_optional(configs) ||
+      sum_pointers(configs) != sum_std_optional(configs)) {
+    std::printf("results differ!\n");
+    return 1;
+  }
+  std::printf("-- %s\n", title);
+  std::size_t ops = kSize * kRounds;
+  bench::run("raw pointers (hand-written)", ops, [&] {
+    for (int r = 0; r < kRounds; ++r)
+      bench::do_not_optimize(sum_pointers(configs));
+  });
+  bench::run("optional_view and_then/transform", ops, [&] {
+    for (int r = 0; r < kRounds; ++r)
+      bench::do_not_optimize(sum_optional_view(configs));
+  });
+  bench::run("std::optional and_then/transform (C++23)", ops, [&] {
+    for (int r = 0; r < kRounds; ++r)
+      bench::do_not_optimize(sum_std_optional(configs));
+  });
+  return 0;
+}
+
+int main() {
+  return run_all<FlatServer>("trivially copyable server (64 ints inline)") +
+         run_all<HeapServer>("server owning a std::vector (64 ints)");
+}
+#endif
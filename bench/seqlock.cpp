@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+// seqlock_optional_view read scaling vs std::mutex and std::shared_ptr
+// N reader threads read a small struct millions of times, while one
+// writer updates it about every millisecond. Seqlock readers never write
+// to shared memory, so throughput should grow with readers; mutex and
+// shared_ptr readers write to a shared cache line on every read (lock
+// word, or reference count), which bounces among cores.
+// Usage: ./bench_seqlock [max_readers] (default: hardware concurrency)
+
+#include <opview/seqlock_optional_view.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+
+struct Limits {
+  int low;
+  int high;
+  int burst;
+  int timeout;
+};
+
+constexpr int kReadsPerThread = 2000000;
+
+// runs 'readers' threads calling read() kReadsPerThread times each, with
+// a concurrent writer calling write(); prints aggregate throughput
+template <typename Read, typename Write>
+void run_scaling(const char* name, unsigned readers, Read&& read,
+                 Write&& write) {
+  std::atomic<bool> go{false};
+  std::atomic<bool> done{false};
+  std::atomic<unsigned> ready{0};
+  std::thread writer{[&] {
+    int i = 0;
+    while (!done.load(std::memory_order_relaxed)) {
+      write(++i);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }};
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < readers; ++t) {
+    threads.emplace_back([&] {
+      ready.fetch_add(1);
+      while (!go.load(std::memory_order_acquire)) {
+      }
+      long long sum = 0;
+      for (int i = 0; i < kReadsPerThread; ++i) sum += read();
+      bench::do_not_optimize(sum);
+    });
+  }
+  while (ready.load() != readers) {
+  }
+  auto start = std::chrono::steady_clock::now();
+  go.store(true, std::memory_order_release);
+  for (auto& th : threads) th.join();
+  auto end = std::chrono::steady_clock::now();
+  done.store(true);
+  writer.join();
+  double sec = std::chrono::duration<double>(end - start).count();
+  double total = static_cast<double>(kReadsPerThread) * readers;
+  std::printf("%-28s readers=%-3u %9.1f Mreads/s\n", name, readers,
+              total / sec / 1e6);
+}
+
+int main(int argc, char** argv) {
+  unsigned max_readers = std::thread::hardware_concurrency();
+  if (argc > 1) max_readers = static_cast<unsigned>(std::atol(argv[1]));
+  if (max_readers == 0) max_readers = 1;
+
+  opview::seqlock_optional_view<Limits> seq{Limits{1, 100, 10, 5}};
+  std::mutex mutex;
+  std::optional<Limits> guarded{Limits{1, 100, 10, 5}};
+  auto shared = std::make_shared<const Limits>(Limits{1, 100, 10, 5});
+
+  for (unsigned readers = 1; readers <= max_readers; readers *= 2) {
+    run_scaling(
+        "seqlock_optional_view", readers,
+        [&] {
+          return seq.read([](opview::const_optional_view<Limits> lim) {
+            return lim ? lim->high - lim->low : 0;
+          });
+        },
+        [&](int i) { seq.store(Limits{1, 100 + i % 10, 10, 5}); });
+    run_scaling(
+        "std::mutex + std::optional", readers,
+        [&] {
+          std::lock_guard<std::mutex> lock{mutex};
+          return guarded ? guarded->high - guarded->low : 0;
+        },
+        [&](int i) {
+          std::lock_guard<std::mutex> lock{mutex};
+          guarded = Limits{1, 100 + i % 10, 10, 5};
+        });
+    run_scaling(
+        "std::atomic_load(shared_ptr)", readers,
+        [&] {
+          auto lim = std::atomic_load(&shared);
+          return lim ? lim->high - lim->low : 0;
+        },
+        [&](int i) {
+          std::atomic_store(&shared, std::make_shared<const Limits>(
+                                         Limits{1, 100 + i % 10, 10, 5}));
+        });
+  }
+  return 0;
+}
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+// value_or/ref_or vs hand-written 'ov ? *ov : dflt'
+// Hand-written version must branch (*ov cannot be loaded before the null
+// check), so it pays branch misses on randomly engaged views. value_or
+// selects the address first (cmov), then loads once: no data-dependent
+// branch. Compare with: perf stat -e branches,branch-misses ./bench_value_or
+
+#include <opview/optional_view.hpp>
+#include <opview/storable_optional_view.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+
+using opview::const_optional_view;
+using opview::storable_optional_view;
+
+constexpr std::size_t kSize = 1 << 16;  // fits in cache: branches dominate
+constexpr int kRounds = 200;
+
+// hides the body from the caller loop, as a real call site would see it
+__attribute__((noinline)) long long sum_branchy(
+    const std::vector<storable_optional_view<const int>>& views, int dflt) {
+  long long sum = 0;
+  for (const auto& sv : views) {
+    const_optional_view<int> ov = sv.view();
+    sum += ov ? *ov : dflt;
+  }
+  return sum;
+}
+
+__attribute__((noinline)) long long sum_value_or(
+    const std::vector<storable_optional_view<const int>>& views, int dflt) {
+  long long sum = 0;
+  for (const auto& sv : views) sum += sv.view().value_or(dflt);
+  return sum;
+}
+
+__attribute__((noinline)) long long sum_ref_or(
+    const std::vector<storable_optional_view<const int>>& views,
+    const int& fallback) {
+  long long sum = 0;
+  for (const auto& sv : views) sum += sv.view().ref_or(fallback);
+  return sum;
+}
+
+void run_pattern(const char* pattern, double engaged_ratio,
+                 const std::vector<int>& data) {
+  std::bernoulli_distribution engaged{engaged_ratio};
+  std::vector<storable_optional_view<const int>> views;
+  views.reserve(data.size());
+  for (const int& d : data) {
+    if (engaged(bench::rng()))
+      views.push_back(d);
+    else
+      views.push_back(std::nullopt);
+  }
+  std::printf("-- %s\n", pattern);
+  const int fallback = -1;
+  std::size_t ops = kSize * kRounds;
+  bench::run("hand-written ov ? *ov : dflt", ops, [&] {
+    for (int r = 0; r < kRounds; ++r)
+      bench::do_not_optimize(sum_branchy(views, -1));
+  });
+  bench::run("value_or(dflt)", ops, [&] {
+    for (int r = 0; r < kRounds; ++r)
+      bench::do_not_optimize(sum_value_or(views, -1));
+  });
+  bench::run("ref_or(fallback)", ops, [&] {
+    for (int r = 0; r < kRounds; ++r)
+      bench::do_not_optimize(sum_ref_or(views, fallback));
+  });
+}
+
+int main() {
+  std::vector<int> data(kSize);
+  for (std::size_t i = 0; i < kSize; ++i) data[i] = static_cast<int>(i);
+  run_pattern("all engaged (predictable)", 1.0, data);
+  run_pattern("90% engaged, random", 0.9, data);
+  run_pattern("50% engaged, random", 0.5, data);
+  return 0;
+}
@@ -6,14 +6,80 @@
 
 // #define OPTIONAL_VIEW_EXTENSIONS
 
+#include <cstdint>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <memory_resource>
+#include <opview/algorithm.hpp>
+#include <opview/atomic_optional_view.hpp>
+#include <opview/epoch.hpp>
+#include <opview/find_view.hpp>
+#include <opview/flat_hash_map.hpp>
+#include <opview/gather.hpp>
+#include <opview/optional_column_view.hpp>
+#include <opview/optional_shared_view.hpp>
 #include <opview/optional_unique_view.hpp>
 #include <opview/optional_view.hpp>
+#include <opview/perfect_map.hpp>
+#include <opview/sentinel_optional_view.hpp>
+#include <opview/seqlock_optional_view.hpp>
+#include <opview/slot_map.hpp>
+#include <opview/storable_optional_view.hpp>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 using opview::const_optional_view;
+using opview::local_optional_shared_view;
+using opview::make_optional_unique_view;
+using opview::optional_shared_view;
 using opview::optional_unique_view;
 using opview::optional_view;
+using opview::sentinel_optional_view;
+using opview::storable_optional_view;
+
+// optional_view is usable in constant expressions (e.g., static config)
+constexpr int kDefaultPort = 8080;
+constexpr const_optional_view<int> kPort{kDefaultPort};
+constexpr const_optional_view<int> kNoPort{std::nullopt};
+static_assert(kPort && *kPort == 8080 && kNoPort.empty());
+static_assert(!kNoPort && !kPort.empty());
+static_assert(kPort.get() == 8080);
+static_assert(kPort.value_or(1) == 8080 && kNoPort.value_or(1) == 1);
+static_assert(kNoPort.ref_or(kDefaultPort) == 8080);
+// converting constructor (here, to a checked access policy)
+static_assert(*optional_view<const int, opview::trap_access>{kPort} == 8080);
+struct Endpoint {
+  int port;
+};
+constexpr Endpoint kEndpoint{kDefaultPort};
+constexpr const_optional_view<Endpoint> kEp{kEndpoint};
+constexpr const_optional_view<Endpoint> kNoEp{std::nullopt};
+static_assert(*kEp.project(&Endpoint::port) == 8080);
+static_assert(!kNoEp.project(&Endpoint::port));
+// monadic operations too (also on C++17)
+static_assert(kPort.transform([](const int& p) { return p + 1; }) == 8081);
+static_assert(!kNoPort.transform([](const int& p) { return p + 1; }));
+// visit_engaged too: one test per view, then f(const int&) or f(nullopt)
+constexpr int port_or_zero(const int& port) { return port; }
+constexpr int port_or_zero(std::nullopt_t) { return 0; }
+static_assert(opview::visit_engaged(
+                  [](const auto& a, const auto& b) {
+                    return port_or_zero(a) + port_or_zero(b);
+                  },
+                  kPort, kNoPort) == 8080);
+// const views test as bool (contextually), but never convert to integers
+static_assert(!std::is_convertible<const optional_view<int>&, int>::value);
+static_assert(!std::is_convertible<storable_optional_view<int>, int>::value);
+static_assert(
+    !std::is_convertible<sentinel_optional_view<std::string>, int>::value);
+
+// fixed table, built at compile time (no startup initialization)
+constexpr auto kMethods = opview::make_perfect_map<std::string_view, int>(
+    {{"GET", 1}, {"PUT", 2}, {"POST", 3}, {"DELETE", 4}});
+static_assert(*kMethods.lookup("POST") == 3 && !kMethods.lookup("PATCH"));
 
 void f(optional_view<int> maybe_int) {
   if (maybe_int)
@@ -29,6 +95,56 @@ void g(optional_unique_view<int> maybe_int) {
     std::cout << "empty" << std::endl;
 }
 
+// small temporaries are kept inline: g2(10) does not allocate
+void g2(optional_unique_view<int, sizeof(int)> maybe_int) {
+  if (maybe_int)
+    std::cout << *maybe_int << std::endl;
+  else
+    std::cout << "empty" << std::endl;
+}
+
+// owned temporaries come from a memory resource (here, an arena)
+void g3(opview::pmr::optional_unique_view<int> maybe_int) {
+  if (maybe_int)
+    std::cout << *maybe_int << std::endl;
+  else
+    std::cout << "empty" << std::endl;
+}
+
+void h(optional_shared_view<int> maybe_int) {
+  if (maybe_int)
+    std::cout << *maybe_int << " (" << maybe_int.use_count() << ")"
+              << std::endl;
+  else
+    std::cout << "empty" << std::endl;
+}
+
+// scales (and shifts) all elements: checks are hoisted out of the loop,
+// as each engaged/empty combination gets its own loop
+void scale(std::vector<int>& data, optional_view<const int> factor,
+           optional_view<const int> offset) {
+  opview::visit_engaged(
+      [&](const auto& f, const auto& o) {
+        for (int& d : data) {
+          if constexpr (!opview::is_nullopt_v<decltype(f)>) d *= f;
+          if constexpr (!opview::is_nullopt_v<decltype(o)>) d += o;
+        }
+      },
+      factor, offset);
+}
+
+// simple linked structure, for null-propagating projections
+struct Node {
+  int value;
+  Node* next;
+};
+
+// trivially copyable state, shared among threads
+struct Limits {
+  int low;
+  int high;
+};
+
 int main() {
   int x = 10;
   f(x);  // prints 10
@@ -58,6 +174,110 @@ int main() {
   //
   *op_y = 25;                     // remote change on std::optional
   std::cout << *oz << std::endl;  // prints 25
+  int fallback = -1;
+  optional_view<int> none{std::nullopt};
+  std::cout << none.value_or(0) << " " << ox.ref_or(fallback) << std::endl;
+  // prints 0 50
+  sentinel_optional_view<int> sx{ox}, snone{none};
+  std::cout << *sx << " " << *snone << " " << snone.empty() << std::endl;
+  // prints 50 0 1 (empty views the default instance, no null check)
+  optional_view<int, opview::throw_access> checked{std::nullopt};
+  try {
+    std::cout << *checked << std::endl;
+  } catch (const std::bad_optional_access&) {
+    std::cout << "bad access" << std::endl;  // prints "bad access"
+  }
+  // monadic chain: no copies, null propagated
+  std::optional<std::pair<int, int>> op_pair{std::pair<int, int>{1, 2}};
+  optional_view<std::pair<int, int>> opair{op_pair};
+  auto second = opair.transform([](auto& p) -> int& { return p.second; });
+  std::cout << *second << " "
+            << none.transform([](int& v) { return v * 2; }).value_or(-2) << " "
+            << *none.or_else([&]() -> optional_view<int> { return ox; })
+            << std::endl;  // prints 2 -2 50
+  auto half = [](int& v) {
+    return v % 2 == 0 ? std::optional<int>{v / 2} : std::nullopt;
+  };
+  std::cout << *ox.and_then(half) << std::endl;  // prints 25
+  Node n3{3, nullptr}, n2{2, &n3}, n1{1, &n2};
+  optional_view<Node> on1{n1};
+  std::cout << *on1.project(&Node::next).project(&Node::next).project(
+                   &Node::value)
+            << " "
+            << on1.project(&Node::next)
+                   .project(&Node::next)
+                   .project(&Node::next)
+                   .project(&Node::value)
+                   .empty()
+            << std::endl;  // prints 3 1
+  const_optional_view<int> cox{ox};  // converts optional_view<int>
+  std::cout << *cox << std::endl;    // prints 50
+  std::vector<int> data{1, 2, 3};
+  int factor = 10;
+  scale(data, factor, std::nullopt);  // data becomes 10 20 30
+  scale(data, std::nullopt, x);       // data becomes 60 70 80
+  std::cout << data[0] << " " << data[2] << std::endl;  // prints 60 80
+  std::vector<storable_optional_view<int>> views;  // views kept in containers
+  for (int& d : data) views.push_back(d);
+  views.push_back(std::nullopt);
+  views[0] = views[2];  // rebinds (only storable views allow that)
+  f(views[0]);          // prints 80: converts back to optional_view
+  f(views[3]);          // prints "empty"
+  std::vector<int> gathered(views.size());
+  opview::gather_or(views, -1, gathered.data());  // dense copy
+  std::cout << gathered[0] << " " << gathered[3] << std::endl;  // prints 80 -1
+  int total = 0;
+  opview::for_each_engaged(views, [&](int& v) { total += v; });  // prefetches
+  std::cout << total << std::endl;  // prints 230 (80 + 70 + 80)
+  opview::atomic_optional_view<const int> current{std::nullopt};
+  current.store(kDefaultPort, std::memory_order_release);  // publish
+  std::cout << *current.load(std::memory_order_acquire) << std::endl;
+  // prints 8080
+  opview::epoch_domain domain;  // deferred reclamation of replaced data
+  opview::atomic_optional_view<const int> snapshot{*new int{1}};
+  {
+    opview::epoch_domain::reader reader{domain};  // once per reader thread
+    opview::epoch_domain::guard guard{reader};
+    auto snap = guard.protect(snapshot);
+    domain.retire(snapshot.exchange(*new int{2}));  // writer replaces it
+    domain.collect();                    // cannot free: reader still inside
+    std::cout << *snap << " " << domain.pending() << std::endl;  // prints 1 1
+  }
+  domain.retire(snapshot.exchange(std::nullopt));
+  domain.synchronize();  // frees both, as no reader is inside a guard
+  opview::seqlock_optional_view<Limits> limits;  // hot, shared state
+  limits.store({1, 100});                        // rare writer
+  int width = limits.read([](const_optional_view<Limits> lim) {
+    return lim ? lim->high - lim->low : 0;  // consistent snapshot
+  });
+  std::cout << width << std::endl;  // prints 99
+  opview::slot_map<int> entities;
+  auto e1 = entities.insert(11);
+  auto e2 = entities.insert(22);
+  entities.erase(e1);                  // e1 is now stale
+  f(entities.find(e1));                // prints "empty" (no dangling)
+  f(entities.find(e2));                // prints 22
+  opview::flat_hash_map<int, int> ports;
+  ports[80] = 8080;
+  f(ports.find_view(80));  // prints 8080 (no find() != end() dance)
+  f(ports.find_view(81));  // prints "empty"
+  std::map<int, int> timeouts{{1, 30}};
+  f(opview::find_view(timeouts, 1));  // prints 30 (single lookup)
+  std::vector<int> retries{3};
+  f(opview::at_view(retries, 9));     // prints "empty" (out of bounds)
+  std::cout << kMethods.lookup("PUT").value_or(0) << std::endl;  // prints 2
+  // nullable column (Arrow-style): rows 0, 2 and 3 present, row 1 absent
+  std::vector<int> col_values{5, 0, 7, 9};
+  std::vector<std::uint8_t> col_validity{0b1101};
+  opview::optional_column_view<int> column{col_values.data(),
+                                           col_validity.data(), 4};
+  f(column[1]);                                    // prints "empty"
+  std::cout << column.null_count() << std::endl;  // prints 1
+  column.for_each_engaged([](std::size_t, int& v) { v += 1; });
+  std::vector<int> dense(4);
+  column.fill_null(-1, dense.data());
+  std::cout << dense[0] << " " << dense[1] << " " << dense[3] << std::endl;
+  // prints 6 -1 10
   //
   // optional_view<int> ow{oz};  // ERROR: ‘const int’ to ‘int&’
   //
@@ -80,5 +300,26 @@ int main() {
   std::cout << (bool)ox2 << std::endl;  // OK: false
   g(std::nullopt);                      // prints "empty"
   g(10);                                // OK: prints 10
+  optional_unique_view<const int> oc{20};  // const T is fine too
+  std::cout << *oc << std::endl;        // OK: prints 20
+  g2(10);                               // OK: prints 10 (no allocation)
+  optional_unique_view<int, sizeof(int)> ox3{30};
+  g2(std::move(ox3));                   // OK: prints 30 (value moved)
+  g(make_optional_unique_view<int>(60));  // OK: prints 60 (built in place)
+  g(std::make_unique<int>(70));  // OK: prints 70 (adopted, no reallocation)
+  optional_unique_view<int> ox4{80};
+  std::unique_ptr<int> p4 = ox4.release_owned();  // ownership leaves the view
+  std::cout << ox4.is_owner() << " " << *ox4 << std::endl;  // prints 0 80
+  std::pmr::monotonic_buffer_resource arena;  // bulk-released at scope exit
+  g3({std::allocator_arg, &arena, 90});       // OK: prints 90 (from arena)
+  std::cout << "BEGIN SHARED PART" << std::endl;
+  h(x2);            // prints 10 (0): borrowed
+  h(std::nullopt);  // prints "empty"
+  optional_shared_view<int> os{100};
+  h(os);            // OK: prints 100 (2): copy shares ownership
+  h(std::move(os));                     // OK: prints 100 (1)
+  local_optional_shared_view<int> ol{110};  // non-atomic counting
+  local_optional_shared_view<int> ol2{ol};
+  std::cout << *ol2 << " " << ol.use_count() << std::endl;  // prints 110 2
   return 0;
 }
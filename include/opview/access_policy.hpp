@@ -0,0 +1,14 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+#ifndef OPVIEW_ACCESS_POLICY_HPP_
+#define OPVIEW_ACCESS_POLICY_HPP_
+
+// Access Policies (unchecked_access, assert_access, trap_access and
+// throw_access) live in optional_view.hpp, so that it remains usable as a
+// single header. This header is kept for compatibility.
+
+#include "optional_view.hpp"
+
+#endif  // OPVIEW_ACCESS_POLICY_HPP_
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+#ifndef OPVIEW_ALGORITHM_HPP_
+#define OPVIEW_ALGORITHM_HPP_
+
+// Algorithms over optional views (optional_view, optional_unique_view, ...
+// or any type with operator bool and operator*).
+//
+// visit_engaged(f, ov1, ov2, ...): tests engagement of every view only
+// once, and calls f with T& for engaged views and std::nullopt for empty
+// ones. So, f is instantiated for each engaged/empty combination (up to
+// 2^N versions), and loops inside f need no further checks at all
+// (loop unswitching, done at compile time).
+// All instantiations of f must return the same type. Usable in constant
+// expressions (also on C++17).
+//
+// for_each_engaged(first, last, f, distance): calls f(T&) for each engaged
+// view in [first, last), software-pipelined: view 'distance' positions
+// ahead is prefetched, so cache misses on *view overlap with work on
+// previous elements (views need a prefetch() method).
+
+#include <cstddef>      // for std::size_t
+#include <functional>   // for std::invoke
+#include <iterator>     // for std::begin, std::end
+#include <optional>     // for std::nullopt
+#include <tuple>        // for std::forward_as_tuple
+#include <type_traits>  // for std::is_same
+#include <utility>      // for std::forward
+
+#include "optional_view.hpp"
+
+namespace opview {
+
+// is argument of visit_engaged a std::nullopt (empty view)?
+template <typename T>
+inline constexpr bool is_nullopt_v =
+    std::is_same<std::remove_cv_t<std::remove_reference_t<T>>,
+                 std::nullopt_t>::value;
+
+namespace detail {
+template <std::size_t I, typename F, typename Views, typename... Args>
+constexpr decltype(auto) visit_engaged_impl(F& f, Views& views,
+                                            Args&&... args) {
+  if constexpr (I == std::tuple_size<Views>::value) {
+    return detail::invoke(f, std::forward<Args>(args)...);
+  } else {
+    auto& view = std::get<I>(views);
+    if (view)
+      return visit_engaged_impl<I + 1>(f, views, std::forward<Args>(args)...,
+                                       *view);
+    else
+      return visit_engaged_impl<I + 1>(f, views, std::forward<Args>(args)...,
+                                       std::nullopt);
+  }
+}
+}  // namespace detail
+
+template <typename F, typename... Views>
+constexpr decltype(auto) visit_engaged(F&& f, Views&&... views) {
+  auto refs = std::forward_as_tuple(views...);
+  return detail::visit_engaged_impl<0>(f, refs);
+}
+
+// default prefetch distance, in elements
+inline constexpr std::size_t default_prefetch_distance = 8;
+
+template <typename RandomIt, typename F>
+void for_each_engaged(RandomIt first, RandomIt last, F&& f,
+                      std::size_t distance = default_prefetch_distance) {
+  auto n = static_cast<std::size_t>(last - first);
+  std::size_t i = 0;
+  // prologue: prefetch views needed first
+  for (std::size_t k = 0; k < distance && k < n; ++k) first[k].prefetch();
+  // steady state: prefetch ahead, with no bounds check
+  for (; i + distance < n; ++i) {
+    first[i + distance].prefetch();
+    auto& view = first[i];
+    if (view) std::invoke(f, *view);
+  }
+  // epilogue: everything already prefetched
+  for (; i < n; ++i) {
+    auto& view = first[i];
+    if (view) std::invoke(f, *view);
+  }
+}
+
+template <typename Range, typename F>
+void for_each_engaged(Range&& views, F&& f,
+                      std::size_t distance = default_prefetch_distance) {
+  for_each_engaged(std::begin(views), std::end(views), std::forward<F>(f),
+                   distance);
+}
+
+}  // namespace opview
+
+#endif  // OPVIEW_ALGORITHM_HPP_
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+#ifndef OPVIEW_ATOMIC_OPTIONAL_VIEW_HPP_
+#define OPVIEW_ATOMIC_OPTIONAL_VIEW_HPP_
+
+// Atomic Optional View:
+// a slot to publish an optional reference among threads, such as
+// "current config" or "current snapshot", with the optional_view
+// vocabulary: load() gives a plain optional_view<T>, so readers pay only
+// an (acquire) atomic load. It is always lock-free (a single T*).
+// As in optional_view, there is no ownership: lifetime of published data
+// must be managed elsewhere (see epoch.hpp for deferred reclamation).
+// Compare-exchange takes 'expected' as storable_optional_view<T>, since
+// it must be rebound on failure (optional_view cannot be reassigned).
+
+#include <atomic>       // for std::atomic
+#include <optional>     // for std::nullopt
+
+#include "optional_view.hpp"
+#include "storable_optional_view.hpp"
+
+namespace opview {
+//
+template <typename T, typename Access = unchecked_access>
+class atomic_optional_view {  // NOLINT
+  using value_type = T;
+
+ public:
+  using view_type = optional_view<T, Access>;
+
+  static constexpr bool is_always_lock_free =
+      std::atomic<T*>::is_always_lock_free;
+
+  static_assert(is_always_lock_free,
+                "atomic_optional_view requires lock-free atomic pointers");
+
+ private:
+  std::atomic<T*> value{nullptr};
+
+  static constexpr T* pointer(const view_type& view) noexcept {
+    return detail::view_access::pointer(view);
+  }
+
+  static constexpr view_type make(T* ptr) noexcept {
+    return detail::view_access::make<T, Access>(ptr);
+  }
+
+ public:
+  constexpr atomic_optional_view() noexcept = default;
+
+  // NOLINTNEXTLINE
+  constexpr atomic_optional_view(view_type desired) noexcept
+      : value{pointer(desired)} {}
+
+  // as std::atomic: not copyable nor movable
+  atomic_optional_view(const atomic_optional_view&) = delete;
+
+  atomic_optional_view& operator=(const atomic_optional_view&) = delete;
+
+  bool is_lock_free() const noexcept { return value.is_lock_free(); }
+
+  view_type load(
+      std::memory_order order = std::memory_order_seq_cst) const noexcept {
+    return make(value.load(order));
+  }
+
+  // NOLINTNEXTLINE
+  operator view_type() const noexcept { return load(); }
+
+  void store(view_type desired,
+             std::memory_order order = std::memory_order_seq_cst) noexcept {
+    value.store(pointer(desired), order);
+  }
+
+  view_type exchange(
+      view_type desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return make(value.exchange(pointer(desired), order));
+  }
+
+  // on failure, 'expected' is rebound to the current view
+  bool compare_exchange_weak(storable_optional_view<T, Access>& expected,
+                             view_type desired, std::memory_order success,
+                             std::memory_order failure) noexcept {
+    T* ptr = pointer(expected.view());
+    bool ok = value.compare_exchange_weak(ptr, pointer(desired), success,
+                                          failure);
+    if (!ok) expected = make(ptr);
+    return ok;
+  }
+
+  bool compare_exchange_weak(
+      storable_optional_view<T, Access>& expected, view_type desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept {
+    T* ptr = pointer(expected.view());
+    bool ok = value.compare_exchange_weak(ptr, pointer(desired), order);
+    if (!ok) expected = make(ptr);
+    return ok;
+  }
+
+  // on failure, 'expected' is rebound to the current view
+  bool compare_exchange_strong(storable_optional_view<T, Access>& expected,
+                               view_type desired, std::memory_order success,
+                               std::memory_order failure) noexcept {
+    T* ptr = pointer(expected.view());
+    bool ok = value.compare_exchange_strong(ptr, pointer(desired), success,
+                                            failure);
+    if (!ok) expected = make(ptr);
+    return ok;
+  }
+
+  bool compare_exchange_strong(
+      storable_optional_view<T, Access>& expected, view_type desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept {
+    T* ptr = pointer(expected.view());
+    bool ok = value.compare_exchange_strong(ptr, pointer(desired), order);
+    if (!ok) expected = make(ptr);
+    return ok;
+  }
+
+#if defined(__cpp_lib_atomic_wait) && __cpp_lib_atomic_wait >= 201907L
+  // blocks while current view is still 'old' (C++20)
+  void wait(view_type old, std::memory_order order =
+                               std::memory_order_seq_cst) const noexcept {
+    value.wait(pointer(old), order);
+  }
+
+  void notify_one() noexcept { value.notify_one(); }
+
+  void notify_all() noexcept { value.notify_all(); }
+#endif
+};
+
+}  // namespace opview
+
+#endif  // OPVIEW_ATOMIC_OPTIONAL_VIEW_HPP_
@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+#ifndef OPVIEW_BITS_HPP_
+#define OPVIEW_BITS_HPP_
+
+// Bit helpers (internal), shared by bitmap and hash table kernels:
+// compiler builtins when available, portable loops otherwise
+// (std::popcount and std::countr_zero are C++20 only).
+
+#include <cstdint>  // for std::uint64_t
+
+namespace opview {
+
+namespace detail {
+inline int popcount64(std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(word);
+#else
+  int count = 0;
+  for (; word; word &= word - 1) ++count;
+  return count;
+#endif
+}
+
+// index of lowest set bit (word must not be zero)
+inline int countr_zero64(std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(word);
+#else
+  int index = 0;
+  for (; !(word & 1U); word >>= 1) ++index;
+  return index;
+#endif
+}
+}  // namespace detail
+
+}  // namespace opview
+
+#endif  // OPVIEW_BITS_HPP_
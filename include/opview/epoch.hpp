@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+#ifndef OPVIEW_EPOCH_HPP_
+#define OPVIEW_EPOCH_HPP_
+
+// Epoch-based reclamation for optional views:
+// an optional_view into concurrently updated data (for instance, loaded
+// from an atomic_optional_view) would dangle if a writer frees its target.
+// So, writers do not free replaced objects immediately: they retire() them
+// into an epoch_domain, and collect() frees them only after a grace period,
+// when no reader can still be viewing them.
+// Readers register once per thread (epoch_domain::reader), and open a
+// read-side critical section with an epoch_domain::guard: views obtained
+// through guard.protect() are valid until the guard is destroyed.
+// Read side pays no atomic read-modify-write: entering is a relaxed load,
+// a store and a fence, leaving is a release store (nothing is shared among
+// readers, each one writes only to its own cache line).
+//
+// Usage:
+//   epoch_domain domain;                          // shared
+//   atomic_optional_view<const Config> current;   // shared
+//   // reader thread
+//   epoch_domain::reader r{domain};
+//   { epoch_domain::guard g{r}; auto cfg = g.protect(current); ... }
+//   // writer thread
+//   domain.retire(current.exchange(*new_config));  // old one, if any
+//   domain.collect();
+
+#include <atomic>       // for std::atomic
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint64_t
+#include <mutex>        // for std::mutex
+#include <thread>       // for std::this_thread::yield
+#include <type_traits>  // for std::remove_cv_t
+#include <vector>       // for std::vector
+
+#include "atomic_optional_view.hpp"
+#include "optional_view.hpp"
+
+namespace opview {
+//
+class epoch_domain {
+ private:
+  static constexpr std::uint64_t inactive = 0;  // reader outside guard
+
+  // one per registered reader thread, on its own cache line
+  struct alignas(64) reader_record {
+    std::atomic<std::uint64_t> epoch{inactive};
+    std::atomic<bool> in_use{true};
+    reader_record* next{nullptr};
+    std::size_t nesting{0};  // only touched by owner thread
+  };
+
+  struct retired_object {
+    void* ptr;
+    void (*deleter)(void*);
+    std::uint64_t epoch;
+  };
+
+  std::atomic<std::uint64_t> global_epoch{1};
+  std::atomic<reader_record*> records{nullptr};  // push-only list
+  std::mutex retire_mutex;
+  std::vector<retired_object> retired;
+
+  reader_record* acquire_record() {
+    // reuse a record from some finished reader, if any
+    for (reader_record* rec = records.load(std::memory_order_acquire); rec;
+         rec = rec->next) {
+      if (!rec->in_use.load(std::memory_order_relaxed) &&
+          !rec->in_use.exchange(true, std::memory_order_acquire))
+        return rec;
+    }
+    auto* rec = new reader_record{};
+    rec->next = records.load(std::memory_order_relaxed);
+    while (!records.compare_exchange_weak(rec->next, rec,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed)) {
+    }
+    return rec;
+  }
+
+  // all active readers have observed epoch 'current'?
+  bool readers_caught_up(std::uint64_t current) const noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (reader_record* rec = records.load(std::memory_order_acquire); rec;
+         rec = rec->next) {
+      std::uint64_t e = rec->epoch.load(std::memory_order_acquire);
+      if (e != inactive && e != current) return false;
+    }
+    return true;
+  }
+
+  template <typename T>
+  static void delete_object(void* ptr) {
+    delete static_cast<T*>(ptr);
+  }
+
+ public:
+  // registration of a reader thread (use one per thread, not shared)
+  class reader {
+   private:
+    epoch_domain& domain;
+    reader_record* record;
+
+    friend class epoch_domain;
+
+   public:
+    explicit reader(epoch_domain& _domain)
+        : domain{_domain}, record{_domain.acquire_record()} {}
+
+    reader(const reader&) = delete;
+
+    reader& operator=(const reader&) = delete;
+
+    ~reader() { record->in_use.store(false, std::memory_order_release); }
+  };
+
+  // read-side critical section (may be nested on the same reader)
+  class guard {
+   private:
+    reader_record* record;
+
+   public:
+    explicit guard(reader& r) noexcept : record{r.record} {
+      if (record->nesting++ > 0) return;
+      std::uint64_t e = r.domain.global_epoch.load(std::memory_order_relaxed);
+      record->epoch.store(e, std::memory_order_relaxed);
+      // announcement must be visible before any protected load
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    guard(const guard&) = delete;
+
+    guard& operator=(const guard&) = delete;
+
+    ~guard() {
+      if (--record->nesting > 0) return;
+      record->epoch.store(inactive, std::memory_order_release);
+    }
+
+    // view is valid while this guard lives
+    template <typename T, typename Access>
+    optional_view<T, Access> protect(
+        const atomic_optional_view<T, Access>& slot) const noexcept {
+      return slot.load(std::memory_order_acquire);
+    }
+  };
+
+  epoch_domain() = default;
+
+  epoch_domain(const epoch_domain&) = delete;
+
+  epoch_domain& operator=(const epoch_domain&) = delete;
+
+  // all readers must be gone: frees whatever is still retired
+  ~epoch_domain() {
+    for (retired_object& obj : retired) obj.deleter(obj.ptr);
+    reader_record* rec = records.load(std::memory_order_acquire);
+    while (rec) {
+      reader_record* next = rec->next;
+      delete rec;
+      rec = next;
+    }
+  }
+
+  // defers 'delete ptr' until no reader can be viewing it
+  // (ptr must already be unreachable for new readers)
+  template <typename T>
+  void retire(T* ptr) {
+    if (!ptr) return;
+    using U = std::remove_cv_t<T>;
+    std::lock_guard<std::mutex> lock{retire_mutex};
+    std::uint64_t epoch = global_epoch.load(std::memory_order_acquire);
+    retired.push_back(
+        retired_object{const_cast<U*>(ptr), &delete_object<U>, epoch});
+  }
+
+  // same, for a view (typically the result of exchange() on a slot)
+  template <typename T, typename Access>
+  void retire(optional_view<T, Access> old) {
+    retire(detail::view_access::pointer(old));
+  }
+
+  // tries to advance epoch, and frees objects out of their grace period;
+  // returns how many objects were freed
+  std::size_t collect() {
+    std::vector<retired_object> ready;
+    {
+      std::lock_guard<std::mutex> lock{retire_mutex};
+      std::uint64_t current = global_epoch.load(std::memory_order_acquire);
+      if (readers_caught_up(current)) {
+        ++current;
+        global_epoch.store(current, std::memory_order_release);
+      }
+      // retired at epoch e: safe once every reader is past e + 1
+      std::size_t kept = 0;
+      for (retired_object& obj : retired) {
+        if (obj.epoch + 2 <= current)
+          ready.push_back(obj);
+        else
+          retired[kept++] = obj;
+      }
+      retired.resize(kept);
+    }
+    for (retired_object& obj : ready) obj.deleter(obj.ptr);
+    return ready.size();
+  }
+
+  // blocks until every retired object is freed (calling thread must not
+  // be inside a guard)
+  void synchronize() {
+    while (pending() > 0) {
+      collect();
+      std::this_thread::yield();
+    }
+  }
+
+  // number of retired objects still waiting for their grace period
+  std::size_t pending() {
+    std::lock_guard<std::mutex> lock{retire_mutex};
+    return retired.size();
+  }
+};
+
+}  // namespace opview
+
+#endif  // OPVIEW_EPOCH_HPP_
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+#ifndef OPVIEW_FIND_VIEW_HPP_
+#define OPVIEW_FIND_VIEW_HPP_
+
+// Find View:
+// free functions giving optional_view (instead of iterators) for lookups
+// in existing containers, so hit/miss check and access come together (no
+// count() + at() double lookup, nor comparisons against end()):
+// - find_view(map, key): std::map, std::unordered_map, std::flat_map, ...
+//   (anything with mapped_type and find(), heterogeneous if the map is),
+//   or any map with a find_view member (such as opview::flat_hash_map)
+// - find_view_sorted(range, key): contiguous range of pairs sorted by
+//   .first (a "flat map" as std::vector<std::pair<K, V>>), with a
+//   branchless binary search
+// - at_view(container, index): bounds-checked access
+// Const containers give const_optional_view. Temporary containers are
+// rejected, as views would dangle.
+
+#include <cstddef>      // for std::size_t
+#include <functional>   // for std::less
+#include <iterator>     // for std::data, std::size
+#include <type_traits>  // for std::is_const, std::remove_reference_t
+#include <utility>      // for std::declval
+
+#include "optional_view.hpp"
+
+namespace opview {
+
+namespace detail {
+
+template <typename Map, typename Q, typename = void>
+struct has_find_view : std::false_type {};
+
+template <typename Map, typename Q>
+struct has_find_view<
+    Map, Q,
+    std::void_t<decltype(std::declval<Map&>().find_view(
+        std::declval<const Q&>()))>> : std::true_type {};
+
+// mapped_type, keeping constness of Map
+template <typename Map>
+using mapped_view_t =
+    std::conditional_t<std::is_const<Map>::value,
+                       const typename Map::mapped_type,
+                       typename Map::mapped_type>;
+
+}  // namespace detail
+
+template <typename Map, typename Q>
+constexpr auto find_view(Map& map, const Q& key) {
+  if constexpr (detail::has_find_view<Map, Q>::value) {
+    return map.find_view(key);
+  } else {
+    using V = detail::mapped_view_t<Map>;
+    auto it = map.find(key);
+    return detail::view_access::make<V>(it != map.end() ? &it->second
+                                                        : nullptr);
+  }
+}
+
+template <typename Map, typename Q>
+void find_view(const Map&& map, const Q& key) = delete;  // would dangle
+
+// range must be sorted by .first (according to comp)
+template <typename Range, typename Q, typename Compare = std::less<>>
+constexpr auto find_view_sorted(Range& range, const Q& key,
+                                Compare comp = Compare{}) {
+  auto* base = std::data(range);
+  using V = std::remove_reference_t<decltype((base->second))>;
+  std::size_t n = std::size(range);
+  if (n == 0) return detail::view_access::make<V>(nullptr);
+  // lower bound: halving with no data-dependent branch (cmov)
+  while (n > 1) {
+    std::size_t half = n / 2;
+    base = comp(base[half].first, key) ? base + half : base;
+    n -= half;
+  }
+  base += comp(base->first, key);
+  bool found = base != std::data(range) + std::size(range) &&
+               !comp(key, base->first);
+  return detail::view_access::make<V>(found ? &base->second : nullptr);
+}
+
+template <typename Range, typename Q, typename Compare = std::less<>>
+void find_view_sorted(const Range&& range, const Q& key,
+                      Compare comp = Compare{}) = delete;  // would dangle
+
+template <typename Container>
+constexpr auto at_view(Container& c, std::size_t index) {
+  using V = std::remove_reference_t<decltype(c[index])>;
+  return detail::view_access::make<V>(index < std::size(c) ? &c[index]
+                                                           : nullptr);
+}
+
+template <typename Container>
+void at_view(const Container&& c, std::size_t index) = delete;  // dangle
+
+}  // namespace opview
+
+#endif  // OPVIEW_FIND_VIEW_HPP_
@@ -0,0 +1,391 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+#ifndef OPVIEW_FLAT_HASH_MAP_HPP_
+#define OPVIEW_FLAT_HASH_MAP_HPP_
+
+// Flat Hash Map:
+// an open-addressing hash map (Swiss table style), where lookup gives
+// optional_view<V> instead of an iterator: find_view(key) fuses the
+// hit/miss check with the dereference (no comparison against end()).
+// Each slot has one control byte: empty, deleted, or the 7 low bits (h2)
+// of the key hash. Slots are probed in groups of 16 control bytes,
+// compared all at once against h2 (SSE2, or a scalar fallback), so keys
+// are only compared on h2 matches (rarely more than one per lookup).
+// Lookup stops at the first group with an empty byte. Max load is 7/8.
+// Heterogeneous lookup is enabled when both Hash and KeyEqual define
+// is_transparent (as in std::unordered_map, since C++20).
+// Note: as in std::unordered_map, views are invalidated by rehashing
+// (any insertion may rehash; reserve() avoids it).
+
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::int8_t, std::uint64_t
+#include <cstring>      // for std::memset
+#include <functional>   // for std::hash, std::equal_to
+#include <memory>       // for std::allocator
+#include <new>          // for placement new
+#include <type_traits>  // for std::void_t, std::is_nothrow_invocable
+#include <utility>      // for std::pair, std::move, std::forward
+
+#include "bits.hpp"
+#include "optional_view.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define OPVIEW_FLAT_HASH_SSE2 1
+#endif
+
+namespace opview {
+
+namespace detail {
+
+// control bytes (full slots hold h2, in [0, 127])
+inline constexpr std::int8_t ctrl_empty = -128;
+inline constexpr std::int8_t ctrl_deleted = -2;
+inline constexpr std::size_t group_width = 16;
+
+// bitmask of positions (within a group of 16) where ctrl == byte
+inline std::uint32_t group_match(const std::int8_t* group,
+                                 std::int8_t byte) noexcept {
+#ifdef OPVIEW_FLAT_HASH_SSE2
+  __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+  return static_cast<std::uint32_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(byte))));
+#else
+  std::uint32_t mask = 0;
+  for (std::size_t i = 0; i < group_width; ++i)
+    mask |= static_cast<std::uint32_t>(group[i] == byte) << i;
+  return mask;
+#endif
+}
+
+// bitmask of empty or deleted positions (sign bit set)
+inline std::uint32_t group_match_free(const std::int8_t* group) noexcept {
+#ifdef OPVIEW_FLAT_HASH_SSE2
+  __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+  return static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl));
+#else
+  std::uint32_t mask = 0;
+  for (std::size_t i = 0; i < group_width; ++i)
+    mask |= static_cast<std::uint32_t>(group[i] < 0) << i;
+  return mask;
+#endif
+}
+
+// spreads weak hashes (such as identity std::hash<int>) over all bits
+inline std::uint64_t mix_hash(std::size_t hash) noexcept {
+  std::uint64_t h = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+  return h ^ (h >> 32);
+}
+
+}  // namespace detail
+
+//
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class flat_hash_map {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+ private:
+  struct slot {
+    K key;
+    V value;
+  };
+
+  template <typename H, typename E>
+  using enable_transparent =
+      std::void_t<typename H::is_transparent, typename E::is_transparent>;
+
+  std::int8_t* ctrl{nullptr};  // one byte per slot
+  slot* slots{nullptr};
+  std::size_t num_slots{0};    // zero or a power of two (>= 16)
+  std::size_t num_values{0};
+  std::size_t growth_left{0};  // insertions into empty bytes before rehash
+  Hash hash_fn;
+  KeyEqual eq_fn;
+
+  static std::size_t max_load(std::size_t capacity) noexcept {
+    return capacity - capacity / 8;
+  }
+
+  // probes groups with triangular steps (visits all of them, as their
+  // count is a power of two); returns slot index, or num_slots on miss
+  template <typename Q>
+  std::size_t find_index(const Q& key) const {
+    if (num_values == 0) return num_slots;
+    std::uint64_t h = detail::mix_hash(hash_fn(key));
+    auto h2 = static_cast<std::int8_t>(h & 0x7F);
+    std::size_t group_mask = num_slots / detail::group_width - 1;
+    std::size_t group = (h >> 7) & group_mask;
+    for (std::size_t step = 1;; ++step) {
+      const std::int8_t* g = ctrl + group * detail::group_width;
+      for (std::uint32_t m = detail::group_match(g, h2); m; m &= m - 1) {
+        std::size_t i =
+            group * detail::group_width + detail::countr_zero64(m);
+        if (eq_fn(slots[i].key, key)) return i;
+      }
+      if (detail::group_match(g, detail::ctrl_empty)) return num_slots;
+      group = (group + step) & group_mask;
+    }
+  }
+
+  // first empty or deleted slot for hash h (table must have room)
+  static std::size_t find_free(const std::int8_t* ctrl_bytes,
+                               std::size_t capacity,
+                               std::uint64_t h) noexcept {
+    std::size_t group_mask = capacity / detail::group_width - 1;
+    std::size_t group = (h >> 7) & group_mask;
+    for (std::size_t step = 1;; ++step) {
+      const std::int8_t* g = ctrl_bytes + group * detail::group_width;
+      if (std::uint32_t m = detail::group_match_free(g))
+        return group * detail::group_width + detail::countr_zero64(m);
+      group = (group + step) & group_mask;
+    }
+  }
+
+  // values are moved to the new table only when rehash cannot throw
+  // midway (noexcept move and hash), and copied otherwise; so, on an
+  // exception, the old table is left untouched (as in std::vector, a
+  // move-only type with a throwing move is moved anyway)
+  static constexpr bool move_on_rehash =
+      std::is_nothrow_move_constructible<slot>::value &&
+      std::is_nothrow_invocable<Hash&, const K&>::value;
+
+  void rehash(std::size_t capacity) {
+    // new table is fully built before the map changes at all
+    std::allocator<slot> alloc;
+    slot* new_slots = alloc.allocate(capacity);
+    std::int8_t* new_ctrl;
+    try {
+      new_ctrl = new std::int8_t[capacity];
+    } catch (...) {
+      alloc.deallocate(new_slots, capacity);
+      throw;
+    }
+    std::memset(new_ctrl, detail::ctrl_empty, capacity);
+    try {
+      for (std::size_t i = 0; i < num_slots; ++i) {
+        if (ctrl[i] < 0) continue;
+        std::uint64_t h = detail::mix_hash(hash_fn(slots[i].key));
+        std::size_t j = find_free(new_ctrl, capacity, h);
+        if constexpr (move_on_rehash ||
+                      !std::is_copy_constructible<slot>::value)
+          ::new (static_cast<void*>(new_slots + j)) slot{std::move(slots[i])};
+        else
+          ::new (static_cast<void*>(new_slots + j)) slot{slots[i]};
+        new_ctrl[j] = static_cast<std::int8_t>(h & 0x7F);
+      }
+    } catch (...) {
+      for (std::size_t j = 0; j < capacity; ++j)
+        if (new_ctrl[j] >= 0) new_slots[j].~slot();
+      alloc.deallocate(new_slots, capacity);
+      delete[] new_ctrl;
+      throw;
+    }
+    std::size_t count = num_values;
+    release();  // old values (moved-from or copied) and buffers
+    ctrl = new_ctrl;
+    slots = new_slots;
+    num_slots = capacity;
+    num_values = count;
+    growth_left = max_load(capacity) - count;
+  }
+
+  void destroy_all() noexcept {
+    for (std::size_t i = 0; i < num_slots; ++i)
+      if (ctrl[i] >= 0) slots[i].~slot();
+  }
+
+  void release() noexcept {
+    destroy_all();
+    if (slots) std::allocator<slot>{}.deallocate(slots, num_slots);
+    delete[] ctrl;
+    ctrl = nullptr;
+    slots = nullptr;
+    num_slots = num_values = growth_left = 0;
+  }
+
+ public:
+  flat_hash_map() = default;
+
+  flat_hash_map(const flat_hash_map& other)
+      : hash_fn{other.hash_fn}, eq_fn{other.eq_fn} {
+    reserve(other.num_values);
+    other.for_each([this](const K& key, const V& value) {
+      try_emplace(key, value);
+    });
+  }
+
+  flat_hash_map(flat_hash_map&& other) noexcept
+      : ctrl{other.ctrl},
+        slots{other.slots},
+        num_slots{other.num_slots},
+        num_values{other.num_values},
+        growth_left{other.growth_left},
+        hash_fn{std::move(other.hash_fn)},
+        eq_fn{std::move(other.eq_fn)} {
+    other.ctrl = nullptr;
+    other.slots = nullptr;
+    other.num_slots = other.num_values = other.growth_left = 0;
+  }
+
+  flat_hash_map& operator=(flat_hash_map other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~flat_hash_map() { release(); }
+
+  void swap(flat_hash_map& other) noexcept {
+    using std::swap;
+    swap(ctrl, other.ctrl);
+    swap(slots, other.slots);
+    swap(num_slots, other.num_slots);
+    swap(num_values, other.num_values);
+    swap(growth_left, other.growth_left);
+    swap(hash_fn, other.hash_fn);
+    swap(eq_fn, other.eq_fn);
+  }
+
+  std::size_t size() const noexcept { return num_values; }
+
+  bool empty() const noexcept { return num_values == 0; }
+
+  std::size_t capacity() const noexcept { return num_slots; }
+
+  // room for n values with no rehash
+  void reserve(std::size_t n) {
+    if (n <= num_values + growth_left) return;
+    std::size_t capacity = detail::group_width;
+    while (max_load(capacity) < n) capacity *= 2;
+    rehash(capacity);
+  }
+
+  void clear() noexcept {
+    destroy_all();
+    if (ctrl) std::memset(ctrl, detail::ctrl_empty, num_slots);
+    num_values = 0;
+    growth_left = max_load(num_slots);
+  }
+
+  // ===============================================
+  // lookup
+
+  optional_view<V> find_view(const K& key) {
+    std::size_t i = find_index(key);
+    return detail::view_access::make<V>(i != num_slots ? &slots[i].value
+                                                       : nullptr);
+  }
+
+  const_optional_view<V> find_view(const K& key) const {
+    std::size_t i = find_index(key);
+    return detail::view_access::make<const V>(
+        i != num_slots ? &slots[i].value : nullptr);
+  }
+
+  // heterogeneous lookup (transparent Hash and KeyEqual)
+  template <typename Q, typename H = Hash, typename E = KeyEqual,
+            typename = enable_transparent<H, E>>
+  optional_view<V> find_view(const Q& key) {
+    std::size_t i = find_index(key);
+    return detail::view_access::make<V>(i != num_slots ? &slots[i].value
+                                                       : nullptr);
+  }
+
+  template <typename Q, typename H = Hash, typename E = KeyEqual,
+            typename = enable_transparent<H, E>>
+  const_optional_view<V> find_view(const Q& key) const {
+    std::size_t i = find_index(key);
+    return detail::view_access::make<const V>(
+        i != num_slots ? &slots[i].value : nullptr);
+  }
+
+  bool contains(const K& key) const { return find_index(key) != num_slots; }
+
+  template <typename Q, typename H = Hash, typename E = KeyEqual,
+            typename = enable_transparent<H, E>>
+  bool contains(const Q& key) const {
+    return find_index(key) != num_slots;
+  }
+
+  // ===============================================
+  // modifiers
+
+  // returns stored value, and whether it was inserted now
+  template <typename... Args>
+  std::pair<V&, bool> try_emplace(const K& key, Args&&... args) {
+    std::size_t i = find_index(key);
+    if (i != num_slots) return {slots[i].value, false};
+    if (growth_left == 0) {
+      // grows if more than half full, otherwise just drops tombstones
+      bool grow = num_values >= max_load(num_slots) / 2;
+      rehash(num_slots == 0 ? detail::group_width
+                            : (grow ? num_slots * 2 : num_slots));
+    }
+    std::uint64_t h = detail::mix_hash(hash_fn(key));
+    i = find_free(ctrl, num_slots, h);
+    ::new (static_cast<void*>(slots + i))
+        slot{key, V(std::forward<Args>(args)...)};
+    if (ctrl[i] == detail::ctrl_empty) --growth_left;
+    ctrl[i] = static_cast<std::int8_t>(h & 0x7F);
+    ++num_values;
+    return {slots[i].value, true};
+  }
+
+  bool insert(const K& key, const V& value) {
+    return try_emplace(key, value).second;
+  }
+
+  // returns true if inserted, false if assigned
+  bool insert_or_assign(const K& key, const V& value) {
+    auto result = try_emplace(key, value);
+    if (!result.second) result.first = value;
+    return result.second;
+  }
+
+  V& operator[](const K& key) { return try_emplace(key).first; }
+
+  // returns number of erased values (0 or 1)
+  std::size_t erase(const K& key) {
+    std::size_t i = find_index(key);
+    if (i == num_slots) return 0;
+    slots[i].~slot();
+    --num_values;
+    // a group that still has an empty byte never made a probe go past it,
+    // so slot can go back to empty (otherwise, leave a tombstone)
+    const std::int8_t* g =
+        ctrl + (i / detail::group_width) * detail::group_width;
+    if (detail::group_match(g, detail::ctrl_empty)) {
+      ctrl[i] = detail::ctrl_empty;
+      ++growth_left;
+    } else {
+      ctrl[i] = detail::ctrl_deleted;
+    }
+    return 1;
+  }
+
+  // calls f(const K&, V&) for every value (unspecified order)
+  template <typename F>
+  void for_each(F&& f) {
+    for (std::size_t i = 0; i < num_slots; ++i)
+      if (ctrl[i] >= 0)
+        f(static_cast<const K&>(slots[i].key), slots[i].value);
+  }
+
+  template <typename F>
+  void for_each(F&& f) const {
+    for (std::size_t i = 0; i < num_slots; ++i)
+      if (ctrl[i] >= 0)
+        f(static_cast<const K&>(slots[i].key),
+          static_cast<const V&>(slots[i].value));
+  }
+};
+
+}  // namespace opview
+
+#endif  // OPVIEW_FLAT_HASH_MAP_HPP_
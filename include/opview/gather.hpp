@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+#ifndef OPVIEW_GATHER_HPP_
+#define OPVIEW_GATHER_HPP_
+
+// Gather:
+// gather_or(views, n, default, out) writes out[i] = views[i].value_or(default)
+// for a contiguous array of optional_view<T> (or storable_optional_view<T>),
+// producing a dense buffer for vectorized math.
+// By default, it is a scalar (branchless) loop.
+// As optional_view<T> has the same layout as T*, the array is a vector of
+// addresses: when OPVIEW_GATHER_SIMD is defined, for arithmetic T of 4 or
+// 8 bytes, on x86-64, it uses masked hardware gathers (AVX-512F or AVX2,
+// selected at runtime by CPU feature), where empty views are masked off
+// (and get default). This is opt-in, as hardware gathers are not faster
+// than scalar loads on every CPU (see bench/gather.cpp: they may win on
+// cache-resident data, and lose when loads miss cache).
+// Translation units may disagree on OPVIEW_GATHER_SIMD: each setting has
+// its own inline namespace (gather_simd or gather_scalar), so symbols
+// never clash and the linker cannot mix up the two versions.
+
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::int32_t, std::int64_t
+#include <cstring>      // for std::memcpy
+#include <type_traits>  // for std::is_arithmetic
+
+#include "optional_view.hpp"
+#include "storable_optional_view.hpp"
+
+#if defined(OPVIEW_GATHER_SIMD) && \
+    (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <immintrin.h>
+#define OPVIEW_GATHER_X86 1
+#define OPVIEW_GATHER_ABI gather_simd
+#else
+#define OPVIEW_GATHER_ABI gather_scalar
+#endif
+
+namespace opview {
+
+namespace detail {
+
+// address inside an optional view (nullptr when empty)
+template <typename T, typename Access>
+constexpr T* view_pointer(const optional_view<T, Access>& view) noexcept {
+  return view_access::pointer(view);
+}
+
+template <typename T, typename Access>
+constexpr const T* view_pointer(
+    const storable_optional_view<T, Access>& view) noexcept {
+  return view ? &(*view) : nullptr;
+}
+
+template <typename View, typename U>
+void gather_or_scalar(const View* views, std::size_t n, const U& _default,
+                      U* out) {
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto* ptr = view_pointer(views[i]);
+    out[i] = *(ptr ? ptr : &_default);
+  }
+}
+
+#ifdef OPVIEW_GATHER_X86
+// Note: views are read as 64-bit addresses (same layout as T*), with
+// unaligned vector loads; masked-off lanes are never dereferenced.
+
+enum class gather_isa { scalar, avx2, avx512 };
+
+inline gather_isa detect_gather_isa() noexcept {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return gather_isa::avx512;
+  if (__builtin_cpu_supports("avx2")) return gather_isa::avx2;
+  return gather_isa::scalar;
+}
+
+inline gather_isa cached_gather_isa() noexcept {
+  static const gather_isa isa = detect_gather_isa();
+  return isa;
+}
+
+__attribute__((target("avx2"))) inline std::size_t gather64_avx2(
+    const void* views, std::size_t n, std::int64_t _default, void* out) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i dflt = _mm256_set1_epi64x(_default);
+  const auto* src = static_cast<const __m256i*>(views);
+  auto* dst = static_cast<__m256i*>(out);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4, ++src, ++dst) {
+    __m256i addr = _mm256_loadu_si256(src);
+    __m256i mask = _mm256_xor_si256(_mm256_cmpeq_epi64(addr, zero),
+                                    _mm256_set1_epi64x(-1));
+    __m256i vals = _mm256_mask_i64gather_epi64(
+        dflt, static_cast<const long long*>(nullptr), addr, mask, 1);
+    _mm256_storeu_si256(dst, vals);
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) inline std::size_t gather32_avx2(
+    const void* views, std::size_t n, std::int32_t _default, void* out) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m128i dflt = _mm_set1_epi32(_default);
+  // low 32 bits of each 64-bit lane, packed into 128 bits
+  const __m256i pack = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+  const auto* src = static_cast<const __m256i*>(views);
+  auto* dst = static_cast<__m128i*>(out);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4, ++src, ++dst) {
+    __m256i addr = _mm256_loadu_si256(src);
+    __m256i mask64 = _mm256_xor_si256(_mm256_cmpeq_epi64(addr, zero),
+                                      _mm256_set1_epi64x(-1));
+    __m128i mask =
+        _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(mask64, pack));
+    __m128i vals = _mm256_mask_i64gather_epi32(
+        dflt, static_cast<const int*>(nullptr), addr, mask, 1);
+    _mm_storeu_si128(dst, vals);
+  }
+  return i;
+}
+
+__attribute__((target("avx512f"))) inline std::size_t gather64_avx512(
+    const void* views, std::size_t n, std::int64_t _default, void* out) {
+  const __m512i dflt = _mm512_set1_epi64(_default);
+  const auto* src = static_cast<const char*>(views);
+  auto* dst = static_cast<char*>(out);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8, src += 64, dst += 64) {
+    __m512i addr = _mm512_loadu_si512(src);
+    __mmask8 mask = _mm512_test_epi64_mask(addr, addr);
+    __m512i vals = _mm512_mask_i64gather_epi64(dflt, mask, addr, nullptr, 1);
+    _mm512_storeu_si512(dst, vals);
+  }
+  return i;
+}
+
+__attribute__((target("avx512f"))) inline std::size_t gather32_avx512(
+    const void* views, std::size_t n, std::int32_t _default, void* out) {
+  const __m256i dflt = _mm256_set1_epi32(_default);
+  const auto* src = static_cast<const char*>(views);
+  auto* dst = static_cast<char*>(out);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8, src += 64, dst += 32) {
+    __m512i addr = _mm512_loadu_si512(src);
+    __mmask8 mask = _mm512_test_epi64_mask(addr, addr);
+    __m256i vals = _mm512_mask_i64gather_epi32(dflt, mask, addr, nullptr, 1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), vals);
+  }
+  return i;
+}
+
+// vectorized prefix; returns how many elements were written
+template <typename U>
+std::size_t gather_or_simd(const void* views, std::size_t n, const U& _default,
+                           U* out) noexcept {
+  gather_isa isa = cached_gather_isa();
+  if (isa == gather_isa::scalar) return 0;
+  if constexpr (sizeof(U) == 8) {
+    std::int64_t bits = 0;
+    std::memcpy(&bits, &_default, sizeof(U));
+    return isa == gather_isa::avx512 ? gather64_avx512(views, n, bits, out)
+                                     : gather64_avx2(views, n, bits, out);
+  } else {
+    std::int32_t bits = 0;
+    std::memcpy(&bits, &_default, sizeof(U));
+    return isa == gather_isa::avx512 ? gather32_avx512(views, n, bits, out)
+                                     : gather32_avx2(views, n, bits, out);
+  }
+}
+#endif  // OPVIEW_GATHER_X86
+
+inline namespace OPVIEW_GATHER_ABI {
+template <typename View, typename U>
+void gather_or_impl(const View* views, std::size_t n, const U& _default,
+                    U* out) {
+  std::size_t done = 0;
+#ifdef OPVIEW_GATHER_X86
+  static_assert(sizeof(View) == sizeof(void*), "view must be a single T*");
+  if constexpr (std::is_arithmetic<U>::value &&
+                (sizeof(U) == 8 || sizeof(U) == 4))
+    done = gather_or_simd(views, n, _default, out);
+#endif
+  gather_or_scalar(views + done, n - done, _default, out + done);
+}
+}  // namespace OPVIEW_GATHER_ABI
+}  // namespace detail
+
+inline namespace OPVIEW_GATHER_ABI {
+
+// out[i] = views[i].value_or(_default), for i in [0, n)
+template <typename T, typename Access>
+void gather_or(const optional_view<T, Access>* views, std::size_t n,
+               const std::remove_cv_t<T>& _default, std::remove_cv_t<T>* out) {
+  detail::gather_or_impl(views, n, _default, out);
+}
+
+template <typename T, typename Access>
+void gather_or(const storable_optional_view<T, Access>* views, std::size_t n,
+               const std::remove_cv_t<T>& _default, std::remove_cv_t<T>* out) {
+  detail::gather_or_impl(views, n, _default, out);
+}
+
+// same, for any contiguous container of views (std::span, std::vector, ...)
+// with out pointing to (at least) views.size() elements
+template <typename Views, typename U,
+          typename = decltype(std::declval<const Views&>().data())>
+void gather_or(const Views& views, const U& _default, U* out) {
+  gather_or(views.data(), views.size(), _default, out);
+}
+
+}  // namespace OPVIEW_GATHER_ABI
+
+}  // namespace opview
+
+#endif  // OPVIEW_GATHER_HPP_
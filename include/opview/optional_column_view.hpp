@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+#ifndef OPVIEW_OPTIONAL_COLUMN_VIEW_HPP_
+#define OPVIEW_OPTIONAL_COLUMN_VIEW_HPP_
+
+// Optional Column View:
+// a non-owning view to a column of nullable values (as in Apache Arrow):
+// a contiguous array of T, together with a packed validity bitmap, where
+// bit i (least significant bit first) tells if row i is present.
+// Indexing gives optional_view<T>, so each row behaves as an optional_view.
+// Bulk kernels work on whole 64-bit words of the bitmap:
+// - null_count(): popcount
+// - for_each_engaged(f): visits present rows only (skips empty words)
+// - fill_null(default, out): dense copy, nulls replaced (branchless)
+// A null validity pointer means "all rows are present".
+
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint8_t, std::uint64_t
+#include <cstring>      // for std::memcpy
+#include <type_traits>  // for std::is_const
+
+#include "bits.hpp"
+#include "optional_view.hpp"
+
+namespace opview {
+
+namespace detail {
+// loads 64 bits of bitmap, starting at bit 64 * word_index
+// (only the first 'bits' bits are kept, for the last partial word)
+inline std::uint64_t load_bitmap_word(const std::uint8_t* bitmap,
+                                      std::size_t word_index,
+                                      std::size_t bits) noexcept {
+  std::uint64_t word = 0;
+  const std::uint8_t* bytes = bitmap + word_index * 8;
+  if (bits >= 64) {
+    std::memcpy(&word, bytes, sizeof(word));
+    // bitmap is little-endian (bit i of byte j is row 8*j+i)
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+  }
+  for (std::size_t b = 0; b < (bits + 7) / 8; ++b)
+    word |= static_cast<std::uint64_t>(bytes[b]) << (8 * b);
+  return bits == 0 ? 0 : word & (~std::uint64_t{0} >> (64 - bits));
+}
+}  // namespace detail
+
+//
+template <typename T, typename Access = unchecked_access>
+class optional_column_view {  // NOLINT
+  using value_type = T;
+
+ private:
+  T* values{nullptr};
+  const std::uint8_t* validity{nullptr};  // nullptr: all rows are present
+  std::size_t count{0};
+
+  // 64 validity bits starting at row 64 * word_index
+  std::uint64_t word(std::size_t word_index) const noexcept {
+    std::size_t bits = count - word_index * 64;
+    if (validity) return detail::load_bitmap_word(validity, word_index, bits);
+    // all present: only mask the last partial word
+    return bits >= 64 ? ~std::uint64_t{0} : ~(~std::uint64_t{0} << bits);
+  }
+
+  std::size_t num_words() const noexcept { return (count + 63) / 64; }
+
+ public:
+  constexpr optional_column_view() noexcept = default;
+
+  // column of 'size' values, with 'size' bits of validity
+  constexpr optional_column_view(T* _values, const std::uint8_t* _validity,
+                                 std::size_t size) noexcept
+      : values{_values}, validity{_validity}, count{size} {}
+
+  constexpr std::size_t size() const noexcept { return count; }
+
+  constexpr bool empty() const noexcept { return count == 0; }
+
+  // is row i present? (no bounds check)
+  constexpr bool is_valid(std::size_t i) const noexcept {
+    return !validity || ((validity[i >> 3] >> (i & 7)) & 1U);
+  }
+
+  // row i as optional_view (no bounds check)
+  constexpr optional_view<T, Access> operator[](std::size_t i) noexcept {
+    return detail::view_access::make<T, Access>(is_valid(i) ? values + i
+                                                            : nullptr);
+  }
+
+  constexpr const_optional_view<T, Access> operator[](
+      std::size_t i) const noexcept {
+    return detail::view_access::make<const T, Access>(
+        is_valid(i) ? values + i : nullptr);
+  }
+
+  // number of absent rows
+  std::size_t null_count() const noexcept {
+    if (!validity) return 0;
+    std::size_t valid = 0;
+    for (std::size_t w = 0; w < num_words(); ++w)
+      valid += detail::popcount64(word(w));
+    return count - valid;
+  }
+
+  // calls f(i, value) for each present row i, in order
+  template <typename F>
+  void for_each_engaged(F&& f) {
+    for (std::size_t w = 0; w < num_words(); ++w) {
+      for (std::uint64_t bits = word(w); bits; bits &= bits - 1) {
+        std::size_t i = w * 64 + detail::countr_zero64(bits);
+        f(i, values[i]);
+      }
+    }
+  }
+
+  template <typename F>
+  void for_each_engaged(F&& f) const {
+    for (std::size_t w = 0; w < num_words(); ++w) {
+      for (std::uint64_t bits = word(w); bits; bits &= bits - 1) {
+        std::size_t i = w * 64 + detail::countr_zero64(bits);
+        f(i, static_cast<const T&>(values[i]));
+      }
+    }
+  }
+
+  // writes size() values to out, absent rows replaced by _default
+  // (branchless select, so the inner loop can be vectorized)
+  void fill_null(const T& _default, std::remove_cv_t<T>* out) const {
+    for (std::size_t w = 0; w < num_words(); ++w) {
+      std::uint64_t bits = word(w);
+      std::size_t first = w * 64;
+      std::size_t n = (count - first < 64) ? count - first : 64;
+      for (std::size_t k = 0; k < n; ++k)
+        out[first + k] = ((bits >> k) & 1U) ? values[first + k] : _default;
+    }
+  }
+};
+
+}  // namespace opview
+
+#endif  // OPVIEW_OPTIONAL_COLUMN_VIEW_HPP_
@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+#ifndef OPVIEW_OPTIONAL_SHARED_VIEW_HPP_
+#define OPVIEW_OPTIONAL_SHARED_VIEW_HPP_
+
+// #define OPTIONAL_VIEW_EXTENSIONS 1
+
+// Optional Shared View:
+// This is an alternative version to optional_view (and optional_unique_view),
+// where Lifetime Extension (such as in const int&) is supported, and both
+// Copy and Move Semantics are allowed.
+// Resource is usually non-owned (borrowed), as in optional_view. Only when
+// lifetime extension is needed, it is shared among all copies, through an
+// intrusive control block allocated together with the value (single
+// allocation, as in std::make_shared).
+// The RefCount policy selects atomic (thread-safe, default) or non-atomic
+// counting (cheaper, for single-threaded pipelines).
+
+#include <atomic>       // for std::atomic
+#include <cstddef>      // for std::size_t
+#include <optional>     // for std::nullopt
+#include <type_traits>  // for std::enable_if
+#include <utility>      // for std::move, std::in_place
+
+namespace opview {
+
+// thread-safe reference counting (as in std::shared_ptr)
+struct atomic_refcount {
+  using counter_type = std::atomic<std::size_t>;
+
+  static void increment(counter_type& count) noexcept {
+    count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // returns true when last reference is gone
+  static bool decrement(counter_type& count) noexcept {
+    return count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+
+  static std::size_t load(const counter_type& count) noexcept {
+    return count.load(std::memory_order_relaxed);
+  }
+};
+
+// plain reference counting: only for views that never cross threads
+struct nonatomic_refcount {
+  using counter_type = std::size_t;
+
+  static void increment(counter_type& count) noexcept { ++count; }
+
+  // returns true when last reference is gone
+  static bool decrement(counter_type& count) noexcept { return --count == 0; }
+
+  static std::size_t load(const counter_type& count) noexcept {
+    return count;
+  }
+};
+
+namespace detail {
+// control block and value share a single allocation
+template <typename T, typename RefCount>
+struct shared_block {
+  typename RefCount::counter_type refs;
+  T value;
+
+  template <typename... Args>
+  explicit shared_block(Args&&... args)
+      : refs{1}, value(std::forward<Args>(args)...) {}
+};
+}  // namespace detail
+
+//
+template <typename T, typename RefCount = atomic_refcount>
+class optional_shared_view {  // NOLINT
+  using value_type = T;
+  using block_type = detail::shared_block<T, RefCount>;
+
+ private:
+  T* value{nullptr};
+  block_type* block{nullptr};  // only when owning (lifetime extension)
+
+  // points to value inside a fresh control block
+  template <typename... Args>
+  void create(Args&&... args) {
+    block = new block_type(std::forward<Args>(args)...);
+    value = &block->value;
+  }
+
+  void release() noexcept {
+    if (block && RefCount::decrement(block->refs)) delete block;
+  }
+
+ public:
+  optional_shared_view() noexcept = default;
+
+  // do not accept pointer here
+  // explicit optional_shared_view(T* _value) : value{_value} {}
+
+  // this is unsafe: but the risk is yours! (explicit or implicit)
+  // NOLINTNEXTLINE
+  optional_shared_view(T& _value) noexcept : value{&_value} {}
+
+  // support rvalue for lifetime extension (shared among copies)
+  // NOLINTNEXTLINE
+  optional_shared_view(T&& _value) { create(std::move(_value)); }
+
+  // owned T is built in place from constructor arguments (no move)
+  template <typename... Args>
+  explicit optional_shared_view(std::in_place_t, Args&&... args) {
+    create(std::forward<Args>(args)...);
+  }
+
+  // allow nullopt (explicit or implicit)
+  // NOLINTNEXTLINE
+  optional_shared_view(std::nullopt_t) noexcept {}
+
+  // disallow nullptr
+  // NOLINTNEXTLINE
+  optional_shared_view(std::nullptr_t data) = delete;
+
+  // allow optional<T> for compatibility (explicit or implicit)
+  // NOLINTNEXTLINE
+  optional_shared_view(std::optional<T>& op_data) noexcept
+      : value{op_data ? &(*op_data) : nullptr} {}
+
+  template <class X, typename = typename std::enable_if<
+                         std::is_convertible<X*, T*>::value ||
+                         std::is_same<X, T>::value>::type>
+  optional_shared_view(std::optional<X>& op_data) noexcept
+      : value{op_data ? &(*op_data) : nullptr} {}
+
+  // ===============================================
+
+  // copy constructor (shares ownership, if any)
+  optional_shared_view(const optional_shared_view& other) noexcept
+      : value{other.value}, block{other.block} {
+    if (block) RefCount::increment(block->refs);
+  }
+
+  // move constructor
+  optional_shared_view(optional_shared_view&& other) noexcept
+      : value{other.value}, block{other.block} {
+    other.value = nullptr;
+    other.block = nullptr;
+  }
+
+  ~optional_shared_view() { release(); }
+
+  // MUST delete all operator=
+  // This is coherent to *_view behavior, and also prevent misleading issues
+  // with possible rebind or not rebind... this is not needed on a view.
+  optional_shared_view& operator=(const optional_shared_view&) = delete;
+
+  optional_shared_view& operator=(optional_shared_view&&) = delete;
+
+  // return raw pointer
+  T* operator->() noexcept { return value; }
+
+  // return raw pointer
+  const T* operator->() const noexcept { return value; }
+
+  // return dereferenced shared object
+  T& operator*() noexcept { return *value; }
+
+  // return dereferenced shared object
+  const T& operator*() const noexcept { return *value; }
+
+  // return dereferenced shared object
+  T& get() noexcept { return *value; }
+
+  // return dereferenced shared object
+  const T& get() const noexcept { return *value; }
+
+  // return dereferenced shared object
+  operator T&() noexcept { return *value; }
+
+  bool empty() const noexcept { return !(value); }
+
+  // copy of viewed value, or default (selects address, dereferences once)
+  std::remove_cv_t<T> value_or(const T& _default) const
+      noexcept(std::is_nothrow_copy_constructible<T>::value) {
+    return *(value ? value : &_default);
+  }
+
+  // viewed reference, or fallback reference (selects address, no branch)
+  T& ref_or(T& _fallback) noexcept { return *(value ? value : &_fallback); }
+
+  const T& ref_or(const T& _fallback) const noexcept {
+    return *(value ? value : &_fallback);
+  }
+
+  // fallback must outlive the returned reference
+  const T& ref_or(const T&& _fallback) const = delete;
+
+  // has some view?
+  // (non-const overload is needed, otherwise operator T& would be preferred;
+  // const one is explicit, so const views never convert to integers)
+  operator bool() noexcept { return (bool)value; }
+
+  explicit operator bool() const noexcept { return (bool)value; }
+
+  // does this view (share) own its data (lifetime extension)?
+  bool is_owner() const noexcept { return block != nullptr; }
+
+  // number of views sharing the owned data (zero when borrowed or empty)
+  std::size_t use_count() const noexcept {
+    return block ? RefCount::load(block->refs) : 0;
+  }
+
+#ifdef OPTIONAL_VIEW_EXTENSIONS
+  void reset() noexcept {
+    release();
+    value = nullptr;
+    block = nullptr;
+  }
+#endif
+};
+
+// single-threaded version: no atomic increment/decrement on copies
+template <typename T>
+using local_optional_shared_view = optional_shared_view<T, nonatomic_refcount>;
+
+// builds an owning optional_shared_view directly from constructor arguments
+template <typename T, typename RefCount = atomic_refcount, typename... Args>
+optional_shared_view<T, RefCount> make_optional_shared_view(Args&&... args) {
+  return optional_shared_view<T, RefCount>{std::in_place,
+                                           std::forward<Args>(args)...};
+}
+
+}  // namespace opview
+
+#endif  // OPVIEW_OPTIONAL_SHARED_VIEW_HPP_
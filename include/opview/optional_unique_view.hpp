@@ -17,39 +17,244 @@
 // as in optional_view. But on practice, sometimes it
 // may own the resource temporarily, to keep it alive as
 // in lifetime extension.
-
-#include <memory>    // for std::unique_ptr
-#include <optional>  // for std::nullopt
-#include <utility>   // for std::move
+// Small temporaries can be kept inline (no heap allocation), by passing
+// a size threshold InlineSize: any nothrow-movable T with
+// sizeof(T) <= InlineSize is stored inside the view itself.
+// Larger owned values come from Alloc (global new/delete by default); see
+// opview::pmr::optional_unique_view for std::pmr::memory_resource support.
+
+#include <cstddef>          // for std::size_t
+#include <cstdint>          // for std::uintptr_t
+#include <memory>           // for std::unique_ptr, std::allocator_traits
+#include <memory_resource>  // for std::pmr::polymorphic_allocator
+#include <new>              // for placement new
+#include <optional>         // for std::nullopt
+#include <type_traits>      // for std::is_standard_layout
+#include <utility>          // for std::move, std::in_place
+
+#include "optional_view.hpp"
 
 namespace opview {
-//
+
+namespace detail {
+// tagged_ptr: a T* together with an ownership flag.
+// When alignment allows it (alignof(T) >= 2), the flag is packed into the
+// lowest bit of the pointer, so the whole thing fits in a single word.
+template <typename T, bool Packed = (alignof(T) >= 2)>
+class tagged_ptr {
+ private:
+  std::uintptr_t bits{0};
+
+ public:
+  tagged_ptr() = default;
+
+  tagged_ptr(T* ptr, bool owner) noexcept
+      : bits{reinterpret_cast<std::uintptr_t>(ptr) |
+             static_cast<std::uintptr_t>(owner)} {}
+
+  T* get() const noexcept {
+    return reinterpret_cast<T*>(bits & ~static_cast<std::uintptr_t>(1));
+  }
+
+  bool is_owner() const noexcept { return (bits & 1U) != 0; }
+
+  void reset() noexcept { bits = 0; }
+};
+
+// fallback for byte-aligned types: no spare bit, so keep a separate flag
 template <typename T>
-class optional_unique_view {
+class tagged_ptr<T, false> {
+ private:
+  T* ptr{nullptr};
+  bool owner{false};
+
+ public:
+  tagged_ptr() = default;
+
+  tagged_ptr(T* _ptr, bool _owner) noexcept : ptr{_ptr}, owner{_owner} {}
+
+  T* get() const noexcept { return ptr; }
+
+  bool is_owner() const noexcept { return owner; }
+
+  void reset() noexcept {
+    ptr = nullptr;
+    owner = false;
+  }
+};
+
+// inline_buffer: raw storage for an owned T kept inside the view itself.
+// Empty when Size is zero, so it costs nothing (empty base optimization).
+template <std::size_t Size, std::size_t Align>
+struct inline_buffer {
+  alignas(Align) unsigned char data[Size];
+
+  void* address() noexcept { return data; }
+
+  const void* address() const noexcept { return data; }
+};
+
+template <std::size_t Align>
+struct inline_buffer<0, Align> {
+  void* address() noexcept { return nullptr; }
+
+  const void* address() const noexcept { return nullptr; }
+};
+
+// allocator_holder: keeps a (possibly stateful) allocator.
+// Stateless allocators cost nothing (empty base optimization).
+template <typename Alloc, bool Empty = std::is_empty<Alloc>::value &&
+                                       !std::is_final<Alloc>::value>
+class allocator_holder : private Alloc {
+ public:
+  allocator_holder() = default;
+
+  explicit allocator_holder(const Alloc& alloc) : Alloc(alloc) {}
+
+  Alloc& allocator() noexcept { return *this; }
+
+  const Alloc& allocator() const noexcept { return *this; }
+};
+
+template <typename Alloc>
+class allocator_holder<Alloc, false> {
+ private:
+  Alloc alloc;
+
+ public:
+  allocator_holder() = default;
+
+  explicit allocator_holder(const Alloc& _alloc) : alloc{_alloc} {}
+
+  Alloc& allocator() noexcept { return alloc; }
+
+  const Alloc& allocator() const noexcept { return alloc; }
+};
+}  // namespace detail
+
+//
+// Access policy selects checks on dereference (see optional_view.hpp)
+template <typename T, std::size_t InlineSize = 0,
+          typename Alloc = std::allocator<std::remove_cv_t<T>>,
+          typename Access = unchecked_access>
+class optional_unique_view  // NOLINT
+    : private detail::inline_buffer<
+          (sizeof(T) <= InlineSize &&
+           std::is_nothrow_move_constructible<T>::value)
+              ? InlineSize
+              : 0,
+          alignof(T)>,
+      private detail::allocator_holder<Alloc> {
   using value_type = T;
 
+  // allocators work on unqualified types (const T is allocated as T)
+  using stored_type = std::remove_cv_t<T>;
+
+  static_assert(std::is_same<typename Alloc::value_type, stored_type>::value,
+                "Alloc::value_type must be T (without const)");
+
+ public:
+  using allocator_type = Alloc;
+
+  // owned temporaries of T are kept inline (no heap allocation)
+  static constexpr bool stores_inline =
+      sizeof(T) <= InlineSize && std::is_nothrow_move_constructible<T>::value;
+
+  // default allocator means plain new/delete (compatible with unique_ptr)
+  static constexpr bool uses_new_delete =
+      std::is_same<Alloc, std::allocator<stored_type>>::value;
+
  private:
-  std::unique_ptr<T> value;
-  bool is_owner{false};  // default is 'false' here
+  using buffer_type =
+      detail::inline_buffer<stores_inline ? InlineSize : 0, alignof(T)>;
+  using alloc_base = detail::allocator_holder<Alloc>;
+  using alloc_traits = std::allocator_traits<Alloc>;
+
+  // owned/borrowed flag lives in the low bit (default is 'borrowed')
+  detail::tagged_ptr<T> value;
+
+  bool owns_inline() const noexcept {
+    if constexpr (stores_inline)
+      return value.get() == static_cast<const T*>(buffer_type::address());
+    else
+      return false;
+  }
+
+  // creates an owned T: inline when possible, otherwise from Alloc
+  template <typename... Args>
+  T* create(Args&&... args) {
+    if constexpr (stores_inline) {
+      return ::new (buffer_type::address()) T(std::forward<Args>(args)...);
+    } else if constexpr (uses_new_delete) {
+      return new T(std::forward<Args>(args)...);
+    } else {
+      Alloc& alloc = alloc_base::allocator();
+      stored_type* ptr = alloc_traits::allocate(alloc, 1);
+      try {
+        alloc_traits::construct(alloc, ptr, std::forward<Args>(args)...);
+      } catch (...) {
+        alloc_traits::deallocate(alloc, ptr, 1);
+        throw;
+      }
+      return ptr;
+    }
+  }
+
+  void destroy() noexcept {
+    if (!value.is_owner()) return;
+    if (owns_inline()) {
+      value.get()->~T();
+    } else if constexpr (uses_new_delete) {
+      delete value.get();
+    } else {
+      Alloc& alloc = alloc_base::allocator();
+      auto* ptr = const_cast<stored_type*>(value.get());
+      alloc_traits::destroy(alloc, ptr);
+      alloc_traits::deallocate(alloc, ptr, 1);
+    }
+  }
 
  public:
-  optional_unique_view() : value{nullptr} {}
+  optional_unique_view() noexcept = default;
 
   // do not accept pointer here
   // explicit optional_unique_view(T* _value) : value{_value} {}
 
   // this is unsafe: but the risk is yours! (explicit or implicit)
   // NOLINTNEXTLINE
-  optional_unique_view(T& _value) : value{&_value}, is_owner{false} {}
+  optional_unique_view(T& _value) noexcept : value{&_value, false} {}
 
   // support rvalue for lifetime extension
   // NOLINTNEXTLINE
   optional_unique_view(T&& _value)
-      : value{new T{std::move(_value)}}, is_owner{true} {}
+      : value{create(std::move(_value)), true} {}
+
+  // owned T is built in place from constructor arguments (no move)
+  template <typename... Args>
+  explicit optional_unique_view(std::in_place_t, Args&&... args)
+      : value{create(std::forward<Args>(args)...), true} {}
+
+  // allocator-extended versions: owned T comes from the given allocator
+  optional_unique_view(std::allocator_arg_t, const Alloc& alloc, T&& _value)
+      : alloc_base{alloc}, value{create(std::move(_value)), true} {}
+
+  template <typename... Args>
+  optional_unique_view(std::allocator_arg_t, const Alloc& alloc,
+                       std::in_place_t, Args&&... args)
+      : alloc_base{alloc}, value{create(std::forward<Args>(args)...), true} {}
+
+  // adopt an existing heap object (no reallocation, no move)
+  // NOLINTNEXTLINE
+  optional_unique_view(std::unique_ptr<T>&& _value) noexcept
+      : value{_value.get(), _value != nullptr} {
+    static_assert(uses_new_delete,
+                  "std::unique_ptr<T> requires the default allocator");
+    _value.release();  // NOLINT: ownership is now held by this view
+  }
 
   // allow nullopt (explicit or implicit)
   // NOLINTNEXTLINE
-  optional_unique_view(std::nullopt_t data) : value{nullptr}, is_owner{false} {}
+  optional_unique_view(std::nullopt_t data) noexcept {}
 
   // disallow nullptr
   // NOLINTNEXTLINE
@@ -57,70 +262,220 @@ class optional_unique_view {
 
   // allow optional<T> for compatibility (explicit or implicit)
   // NOLINTNEXTLINE
-  optional_unique_view(std::optional<T>& op_data)
-      : value{op_data ? &(*op_data) : nullptr}, is_owner{false} {}
+  optional_unique_view(std::optional<T>& op_data) noexcept
+      : value{op_data ? &(*op_data) : nullptr, false} {}
 
   template <class X, typename = typename std::enable_if<
                          std::is_convertible<X*, T*>::value ||
                          std::is_same<X, T>::value>::type>
-  optional_unique_view(std::optional<X>& op_data)
-      : value{op_data ? &(*op_data) : nullptr}, is_owner{false} {}
+  optional_unique_view(std::optional<X>& op_data) noexcept
+      : value{op_data ? &(*op_data) : nullptr, false} {}
 
   // ===============================================
 
   // disallow copy constructor
-  optional_unique_view(const optional_unique_view<T>& other) = delete;
-
-  // enable move constructor
-  optional_unique_view(optional_unique_view<T>&& other) noexcept
-      : value{std::move(other.value)}, is_owner{other.is_owner} {}
-
-  ~optional_unique_view() {
-    if (!is_owner) value.release();  // prevent double-free
-    value = nullptr;
+  optional_unique_view(const optional_unique_view& other) = delete;
+
+  // enable move constructor (inline values are moved, not stolen)
+  optional_unique_view(optional_unique_view&& other) noexcept
+      : buffer_type{},
+        alloc_base{other.alloc_base::allocator()},
+        value{other.value} {
+    if (other.owns_inline()) {
+      value = detail::tagged_ptr<T>{create(std::move(*other.value.get())),
+                                    true};
+      other.value.get()->~T();
+    }
+    other.value.reset();
   }
 
+  ~optional_unique_view() { destroy(); }
+
   // MUST delete all operator=
   // This is coherent to *_view behavior, and also prevent misleading issues
   // with possible rebind or not rebind... this is not needed on a view.
-  optional_unique_view<T>& operator=(const optional_unique_view<T>&) = delete;
+  optional_unique_view& operator=(const optional_unique_view&) = delete;
 
-  optional_unique_view<T>& operator=(optional_unique_view<T>&&) = delete;
+  optional_unique_view& operator=(optional_unique_view&&) = delete;
 
   // return raw pointer
-  T* operator->() { return value.get(); }
+  T* operator->() noexcept(Access::nothrow) {
+    Access::check(value.get() != nullptr);
+    return value.get();
+  }
 
   // return raw pointer
-  const T* operator->() const { return value.get(); }
+  const T* operator->() const noexcept(Access::nothrow) {
+    Access::check(value.get() != nullptr);
+    return value.get();
+  }
 
   // return dereferenced shared object
-  T& operator*() { return *value; }
+  T& operator*() noexcept(Access::nothrow) {
+    Access::check(value.get() != nullptr);
+    return *value.get();
+  }
 
   // return dereferenced shared object
-  const T& operator*() const { return *value; }
+  const T& operator*() const noexcept(Access::nothrow) {
+    Access::check(value.get() != nullptr);
+    return *value.get();
+  }
 
   // return dereferenced shared object
-  T& get() { return *value; }
+  T& get() noexcept(Access::nothrow) { return **this; }
 
   // return dereferenced shared object
-  const T& get() const { return *value; }
+  const T& get() const noexcept(Access::nothrow) { return **this; }
 
   // return dereferenced shared object
-  operator T&() { return *value; }
+  operator T&() noexcept(Access::nothrow) { return **this; }
+
+  // return dereferenced shared object, with no check at all (whatever the
+  // Access policy): caller guarantees that view is engaged
+  T& value_unchecked() noexcept {
+    OPVIEW_ASSUME(value.get() != nullptr);
+    return *value.get();
+  }
 
-  bool empty() const { return !(value); }
+  const T& value_unchecked() const noexcept {
+    OPVIEW_ASSUME(value.get() != nullptr);
+    return *value.get();
+  }
+
+  bool empty() const noexcept { return !(value.get()); }
+
+  // copy of viewed value, or default (selects address, dereferences once)
+  std::remove_cv_t<T> value_or(const T& _default) const
+      noexcept(std::is_nothrow_copy_constructible<T>::value) {
+    return *(value.get() ? value.get() : &_default);
+  }
+
+  // viewed reference, or fallback reference (selects address, no branch)
+  T& ref_or(T& _fallback) noexcept {
+    return *(value.get() ? value.get() : &_fallback);
+  }
+
+  const T& ref_or(const T& _fallback) const noexcept {
+    return *(value.get() ? value.get() : &_fallback);
+  }
+
+  // fallback must outlive the returned reference
+  const T& ref_or(const T&& _fallback) const = delete;
+
+  // does this view own its data (lifetime extension)?
+  bool is_owner() const noexcept { return value.is_owner(); }
+
+  Alloc get_allocator() const noexcept { return alloc_base::allocator(); }
+
+  // non-owning view to the same data (valid while this view lives)
+  optional_view<T, Access> view() noexcept {
+    return detail::view_access::make<T, Access>(value.get());
+  }
+
+  const_optional_view<T, Access> view() const noexcept {
+    return detail::view_access::make<const T, Access>(value.get());
+  }
+
+  // ===============================================
+  // monadic operations (see optional_view): results never own data
+
+  template <typename F>
+  auto transform(F&& f) {
+    return view().transform(std::forward<F>(f));
+  }
+
+  template <typename F>
+  auto transform(F&& f) const {
+    return view().transform(std::forward<F>(f));
+  }
+
+  template <typename F>
+  auto and_then(F&& f) {
+    return view().and_then(std::forward<F>(f));
+  }
+
+  template <typename F>
+  auto and_then(F&& f) const {
+    return view().and_then(std::forward<F>(f));
+  }
+
+  // view to this data, if engaged, otherwise f() (an optional_view<T>)
+  template <typename F>
+  optional_view<T, Access> or_else(F&& f) {
+    return view().or_else(std::forward<F>(f));
+  }
+
+  // hands ownership back out: the view keeps viewing the same object,
+  // but no longer owns it (returns nullptr when nothing is owned).
+  // Inline values must be moved to heap first.
+  std::unique_ptr<T> release_owned() {
+    static_assert(uses_new_delete,
+                  "std::unique_ptr<T> requires the default allocator");
+    if (!value.is_owner()) return nullptr;
+    T* ptr = value.get();
+    if (owns_inline()) {
+      ptr = new T(std::move(*value.get()));
+      value.get()->~T();
+    }
+    value = detail::tagged_ptr<T>{ptr, false};
+    return std::unique_ptr<T>{ptr};
+  }
 
   // has some view?
-  operator bool() { return (bool)value; }
+  // (non-const overload is needed, otherwise operator T& would be preferred;
+  // const one is explicit, so const views never convert to integers)
+  operator bool() noexcept { return (bool)value.get(); }
+
+  explicit operator bool() const noexcept { return (bool)value.get(); }
 
 #ifdef OPTIONAL_VIEW_EXTENSIONS
   void reset() noexcept {
-    if (!is_owner) value.release();  // prevent double-free
-    value = nullptr;
+    destroy();
+    value.reset();
   }
 #endif
 };
 
+// builds an owning optional_unique_view directly from constructor arguments
+template <typename T, std::size_t InlineSize = 0, typename... Args>
+optional_unique_view<T, InlineSize> make_optional_unique_view(
+    Args&&... args) {
+  return optional_unique_view<T, InlineSize>{std::in_place,
+                                             std::forward<Args>(args)...};
+}
+
+// same, with owned T coming from the given allocator
+template <typename T, std::size_t InlineSize = 0, typename Alloc,
+          typename... Args>
+optional_unique_view<T, InlineSize, Alloc> allocate_optional_unique_view(
+    const Alloc& alloc, Args&&... args) {
+  return optional_unique_view<T, InlineSize, Alloc>{
+      std::allocator_arg, alloc, std::in_place, std::forward<Args>(args)...};
+}
+
+namespace pmr {
+// owned values come from a std::pmr::memory_resource
+// (e.g., a per-request std::pmr::monotonic_buffer_resource)
+template <typename T, std::size_t InlineSize = 0,
+          typename Access = unchecked_access>
+using optional_unique_view =
+    opview::optional_unique_view<T, InlineSize,
+                                 std::pmr::polymorphic_allocator<
+                                     std::remove_cv_t<T>>,
+                                 Access>;
+}  // namespace pmr
+
+// ownership flag is packed into the pointer: a single word, like T*
+static_assert(sizeof(optional_unique_view<int>) == sizeof(int*),
+              "optional_unique_view<T> must have the same size as T*");
+static_assert(std::is_standard_layout<optional_unique_view<int>>::value,
+              "optional_unique_view<T> must be standard layout");
+static_assert(optional_unique_view<int, sizeof(int)>::stores_inline &&
+                  sizeof(optional_unique_view<int, sizeof(int)>) ==
+                      2 * sizeof(int*),
+              "inline storage must only add the buffer to the view");
+
 }  // namespace opview
 
 #endif  // OPVIEW_OPTIONAL_UNIQUE_VIEW_HPP_
@@ -29,14 +29,104 @@
 // and avoid user to take pointer (and maybe even ban pointer interface here).
 // Unsafe ref passing as T& is natural and should be kept.
 
-#include <optional>  // for std::nullopt
+#include <cassert>      // for assert
+#include <functional>   // for std::invoke
+#include <optional>     // for std::nullopt, std::bad_optional_access
+#include <type_traits>  // for std::is_trivially_copyable
+#include <utility>      // for std::forward
+
+#if defined(__clang__)
+#define OPVIEW_ASSUME(cond) __builtin_assume(cond)
+#elif defined(__GNUC__)
+#define OPVIEW_ASSUME(cond)               \
+  do {                                    \
+    if (!(cond)) __builtin_unreachable(); \
+  } while (0)
+#elif defined(_MSC_VER)
+#define OPVIEW_ASSUME(cond) __assume(cond)
+#else
+#define OPVIEW_ASSUME(cond) static_cast<void>(0)
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define OPVIEW_TRAP() __builtin_trap()
+#else
+#include <cstdlib>  // for std::abort
+#define OPVIEW_TRAP() std::abort()
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define OPVIEW_PREFETCH(ptr) __builtin_prefetch(ptr)
+#else
+#define OPVIEW_PREFETCH(ptr) static_cast<void>(ptr)
+#endif
 
 namespace opview {
+
+// Access Policies:
+// These select what happens when an empty view is dereferenced
+// (operator*, operator->, get()), as template parameter Access.
+// - unchecked_access: nothing (default), same code as a raw pointer
+// - assert_access: assert() (only on debug builds, without NDEBUG)
+// - trap_access: abort immediately (also on release builds)
+// - throw_access: throws std::bad_optional_access (as std::optional::value)
+// Independently of the policy, value_unchecked() tells the optimizer
+// that the view is engaged (null checks already done are removed).
+
+struct unchecked_access {
+  static constexpr bool nothrow = true;
+
+  static constexpr void check(bool /*engaged*/) noexcept {}
+};
+
+struct assert_access {
+  static constexpr bool nothrow = true;
+
+  static constexpr void check(bool engaged) noexcept {
+    assert(engaged && "access to empty optional view");
+  }
+};
+
+struct trap_access {
+  static constexpr bool nothrow = true;
+
+  static constexpr void check(bool engaged) noexcept {
+    if (!engaged) OPVIEW_TRAP();
+  }
+};
+
+struct throw_access {
+  static constexpr bool nothrow = false;
+
+  static constexpr void check(bool engaged) {
+    if (!engaged) throw std::bad_optional_access{};
+  }
+};
+
+namespace detail {
+struct view_access;
+
+// std::invoke is only constexpr since C++20: plain callables are called
+// directly, so monadic operations are also constexpr on C++17
+template <typename F, typename... Args>
+constexpr decltype(auto) invoke(F&& f, Args&&... args) {
+  if constexpr (std::is_member_pointer<std::decay_t<F>>::value)
+    return std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+  else
+    return std::forward<F>(f)(std::forward<Args>(args)...);
+}
+}  // namespace detail
+
 //
-template <typename T>
+// Access policy selects checks on dereference (see above)
+template <typename T, typename Access = unchecked_access>
 class optional_view {  // NOLINT
   using value_type = T;
 
+  template <typename, typename>
+  friend class optional_view;
+  friend struct detail::view_access;
+
  private:
 #ifdef OPTIONAL_VIEW_EXTENSIONS
   T* value;  // this allows reset() to make this nullptr
@@ -44,15 +134,58 @@ class optional_view {  // NOLINT
   T* const value;  // no reset() method
 #endif
 
+  // internal only: pointer interface is not exposed to users
+  constexpr explicit optional_view(T* _value) noexcept : value{_value} {}
+
+  // f(T&) -> U& gives optional_view<U> (null propagated, no copy of U);
+  // f(T&) -> U gives std::optional<U>
+  template <typename P, typename F>
+  static constexpr auto transform_impl(P* ptr, F&& f) {
+    using R = std::invoke_result_t<F, P&>;
+    if constexpr (std::is_lvalue_reference<R>::value) {
+      using U = std::remove_reference_t<R>;
+      return optional_view<U, Access>{
+          ptr ? &detail::invoke(std::forward<F>(f), *ptr) : nullptr};
+    } else {
+      static_assert(!std::is_void<R>::value,
+                    "transform requires a non-void result");
+      using U = std::remove_cv_t<R>;
+      return ptr ? std::optional<U>{detail::invoke(std::forward<F>(f), *ptr)}
+                 : std::optional<U>{};
+    }
+  }
+
+  // field member gives view to field; pointer member gives view to pointee
+  template <typename P, typename M, typename S>
+  static constexpr auto project_impl(P* ptr, M S::*member) noexcept {
+    static_assert(!std::is_function<M>::value,
+                  "project requires a data member, not a member function");
+    if constexpr (std::is_pointer<M>::value) {
+      using U = std::remove_pointer_t<M>;
+      return optional_view<U, Access>{ptr ? ptr->*member : nullptr};
+    } else {
+      using U = std::conditional_t<std::is_const<P>::value, const M, M>;
+      return optional_view<U, Access>{ptr ? &(ptr->*member) : nullptr};
+    }
+  }
+
+  // f(T&) must return some optional type (such as optional_view<U>)
+  template <typename P, typename F>
+  static constexpr auto and_then_impl(P* ptr, F&& f) {
+    using R = std::remove_cv_t<
+        std::remove_reference_t<std::invoke_result_t<F, P&>>>;
+    return ptr ? R{detail::invoke(std::forward<F>(f), *ptr)} : R{};
+  }
+
  public:
-  optional_view() : value{nullptr} {}
+  constexpr optional_view() noexcept : value{nullptr} {}
 
   // do not accept pointer here
   // explicit optional_view(T* _value) : value{_value} {}
 
   // this is unsafe: but the risk is yours! (explicit or implicit)
   // NOLINTNEXTLINE
-  optional_view(T& _value) : value{&_value} {}
+  constexpr optional_view(T& _value) noexcept : value{&_value} {}
 
   // cannot support rvalue due to non-ownership semantics
   // NOLINTNEXTLINE
@@ -60,7 +193,7 @@ class optional_view {  // NOLINT
 
   // allow nullopt (explicit or implicit)
   // NOLINTNEXTLINE
-  optional_view(std::nullopt_t data) : value{nullptr} {}
+  constexpr optional_view(std::nullopt_t data) noexcept : value{nullptr} {}
 
   // disallow nullptr
   // NOLINTNEXTLINE
@@ -68,70 +201,196 @@ class optional_view {  // NOLINT
 
   // allow optional<T> for compatibility (explicit or implicit)
   // NOLINTNEXTLINE
-  optional_view(std::optional<T>& op_data)
+  constexpr optional_view(std::optional<T>& op_data) noexcept
       : value{op_data ? &(*op_data) : nullptr} {}
 
   template <class X, typename = typename std::enable_if<
                          std::is_convertible<X*, T*>::value ||
                          std::is_same<X, T>::value>::type>
-  optional_view(std::optional<X>& op_data)
+  constexpr optional_view(std::optional<X>& op_data) noexcept
       : value{op_data ? &(*op_data) : nullptr} {}
 
   // ===============================================
 
-  // copy constructor
-  optional_view(const optional_view<T>& other) : value{other.value} {}
+  // copy constructor (trivial: optional_view is passed in registers, as T*)
+  constexpr optional_view(const optional_view& other) noexcept = default;
 
-  template <class X, typename = typename std::enable_if<
-                         std::is_convertible<X*, T*>::value ||
-                         std::is_same<X, T>::value>::type>
-  optional_view(const optional_view<X>& other) : value{other.value} {}
+  template <class X, class XAccess,
+            typename = typename std::enable_if<
+                std::is_convertible<X*, T*>::value ||
+                std::is_same<X, T>::value>::type>
+  constexpr optional_view(const optional_view<X, XAccess>& other) noexcept
+      : value{other.value} {}
 
   // disable move constructor
-  optional_view(optional_view<T>&& other) = delete;
+  optional_view(optional_view&& other) = delete;
 
   ~optional_view() = default;
 
   // MUST delete all operator=
   // This is coherent to *_view behavior, and also prevent misleading issues
   // with possible rebind or not rebind... this is not needed on a view.
-  optional_view<T>& operator=(const optional_view<T>&) = delete;
+  optional_view& operator=(const optional_view&) = delete;
 
-  optional_view<T>& operator=(optional_view<T>&&) = delete;
+  optional_view& operator=(optional_view&&) = delete;
 
   // return raw pointer
-  T* operator->() { return value; }
+  constexpr T* operator->() noexcept(Access::nothrow) {
+    Access::check(value != nullptr);
+    return value;
+  }
 
   // return raw pointer
-  const T* operator->() const { return value; }
+  constexpr const T* operator->() const noexcept(Access::nothrow) {
+    Access::check(value != nullptr);
+    return value;
+  }
 
   // return dereferenced shared object
-  T& operator*() { return *value; }
+  constexpr T& operator*() noexcept(Access::nothrow) {
+    Access::check(value != nullptr);
+    return *value;
+  }
 
   // return dereferenced shared object
-  const T& operator*() const { return *value; }
+  constexpr const T& operator*() const noexcept(Access::nothrow) {
+    Access::check(value != nullptr);
+    return *value;
+  }
 
   // return dereferenced shared object
-  T& get() { return *value; }
+  constexpr T& get() noexcept(Access::nothrow) { return **this; }
 
   // return dereferenced shared object
-  const T& get() const { return *value; }
+  constexpr const T& get() const noexcept(Access::nothrow) { return **this; }
 
   // return dereferenced shared object
-  operator T&() { return *value; }
+  constexpr operator T&() noexcept(Access::nothrow) { return **this; }
+
+  // return dereferenced shared object, with no check at all (whatever the
+  // Access policy): caller guarantees that view is engaged, so the
+  // optimizer can drop any further null checks on inlined code
+  constexpr T& value_unchecked() noexcept {
+    OPVIEW_ASSUME(value != nullptr);
+    return *value;
+  }
 
-  bool empty() const { return !(value); }
+  constexpr const T& value_unchecked() const noexcept {
+    OPVIEW_ASSUME(value != nullptr);
+    return *value;
+  }
+
+  constexpr bool empty() const noexcept { return !(value); }
+
+  // copy of viewed value, or default (selects address, dereferences once)
+  constexpr std::remove_cv_t<T> value_or(const T& _default) const
+      noexcept(std::is_nothrow_copy_constructible<T>::value) {
+    return *(value ? value : &_default);
+  }
+
+  // viewed reference, or fallback reference (selects address, no branch)
+  constexpr T& ref_or(T& _fallback) noexcept {
+    return *(value ? value : &_fallback);
+  }
+
+  constexpr const T& ref_or(const T& _fallback) const noexcept {
+    return *(value ? value : &_fallback);
+  }
+
+  // fallback must outlive the returned reference
+  const T& ref_or(const T&& _fallback) const = delete;
 
   // has some view?
-  operator bool() { return (bool)value; }
+  // (non-const overload is needed, otherwise operator T& would be preferred;
+  // const one is explicit, so const views never convert to integers)
+  constexpr operator bool() noexcept { return (bool)value; }
+
+  constexpr explicit operator bool() const noexcept { return (bool)value; }
+
+  // hints the CPU to bring viewed data into cache (no-op when empty)
+  void prefetch() const noexcept {
+    if (value) OPVIEW_PREFETCH(value);
+  }
+
+  // ===============================================
+  // monadic operations (as in std::optional, C++23)
+
+  // maps viewed value through f: when f returns a reference, result is
+  // also an optional_view (no copies), otherwise a std::optional
+  template <typename F>
+  constexpr auto transform(F&& f) {
+    return transform_impl(value, std::forward<F>(f));
+  }
+
+  template <typename F>
+  constexpr auto transform(F&& f) const {
+    return transform_impl(static_cast<const T*>(value), std::forward<F>(f));
+  }
+
+  // f returns an optional type itself, which is propagated
+  template <typename F>
+  constexpr auto and_then(F&& f) {
+    return and_then_impl(value, std::forward<F>(f));
+  }
+
+  template <typename F>
+  constexpr auto and_then(F&& f) const {
+    return and_then_impl(static_cast<const T*>(value), std::forward<F>(f));
+  }
+
+  // null-propagating member access (composable for a->b->c paths):
+  // ov.project(&S::field) views field (empty if ov is empty), and
+  // ov.project(&S::ptr) views *ptr (empty if ov is empty or ptr is null)
+  template <typename M, typename S>
+  constexpr auto project(M S::*member) noexcept {
+    return project_impl(value, member);
+  }
+
+  template <typename M, typename S>
+  constexpr auto project(M S::*member) const noexcept {
+    return project_impl(static_cast<const T*>(value), member);
+  }
+
+  // this view, if engaged, otherwise f() (which returns an optional_view)
+  template <typename F>
+  constexpr optional_view or_else(F&& f) const {
+    return value ? optional_view{value}
+                 : optional_view{detail::invoke(std::forward<F>(f))};
+  }
 
 #ifdef OPTIONAL_VIEW_EXTENSIONS
-  void reset() noexcept { value = nullptr; }
+  constexpr void reset() noexcept { value = nullptr; }
 #endif
 };
 
-template <typename T>
-using const_optional_view = optional_view<const T>;
+// optional_view must be layout-compatible with T* and trivially copyable,
+// so that (Itanium ABI) it is passed by value exactly like a raw pointer
+static_assert(sizeof(optional_view<int>) == sizeof(int*),
+              "optional_view<T> must have the same size as T*");
+static_assert(std::is_trivially_copyable<optional_view<int>>::value,
+              "optional_view<T> must be trivially copyable");
+static_assert(std::is_trivially_destructible<optional_view<int>>::value,
+              "optional_view<T> must be trivially destructible");
+static_assert(std::is_nothrow_copy_constructible<optional_view<int>>::value,
+              "optional_view<T> copies must never throw");
+
+template <typename T, typename Access = unchecked_access>
+using const_optional_view = optional_view<const T, Access>;
+
+namespace detail {
+// library-internal access to the pointer inside an optional_view
+struct view_access {
+  template <typename T, typename Access = unchecked_access>
+  static constexpr optional_view<T, Access> make(T* ptr) noexcept {
+    return optional_view<T, Access>{ptr};
+  }
+
+  template <typename T, typename Access>
+  static constexpr T* pointer(const optional_view<T, Access>& view) noexcept {
+    return view.value;
+  }
+};
+}  // namespace detail
 
 }  // namespace opview
 
@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+#ifndef OPVIEW_PERFECT_MAP_HPP_
+#define OPVIEW_PERFECT_MAP_HPP_
+
+// Perfect Map:
+// a fixed, read-only map built at compile time (for tables such as
+// opcodes, header names or enum strings), with a collision-free hash:
+// lookup(key) gives const_optional_view<V>, with one hash of the key and
+// a single key comparison. Everything is constexpr, so a constant lookup
+// folds away entirely (and there is no startup initialization at all).
+// Keys may be integral, enums, or strings (std::string_view).
+// Construction uses hash-and-displace (CHD): keys are split into buckets
+// by hash, and each bucket (largest first) gets a displacement that sends
+// all its keys to free slots. Table has at least 2N slots, so every
+// displacement is found quickly. Duplicate keys are an error (at compile
+// time, if map is constexpr).
+//
+// Usage:
+//   constexpr auto codes = make_perfect_map<std::string_view, int>(
+//       {{"GET", 1}, {"PUT", 2}, {"POST", 3}});
+//   static_assert(*codes.lookup("PUT") == 2);
+
+#include <array>        // for std::array
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint32_t, std::uint64_t
+#include <stdexcept>    // for std::invalid_argument
+#include <string_view>  // for std::string_view
+#include <type_traits>  // for std::is_integral, std::is_same
+#include <utility>      // for std::pair, std::index_sequence
+
+#include "optional_view.hpp"
+
+namespace opview {
+
+namespace detail {
+
+// splitmix64 finalizer
+constexpr std::uint64_t perfect_mix(std::uint64_t h) noexcept {
+  h ^= h >> 30;
+  h *= 0xBF58476D1CE4E5B9ULL;
+  h ^= h >> 27;
+  h *= 0x94D049BB133111EBULL;
+  return h ^ (h >> 31);
+}
+
+template <typename K>
+constexpr std::uint64_t perfect_key_hash(const K& key) noexcept {
+  if constexpr (std::is_integral<K>::value || std::is_enum<K>::value) {
+    return perfect_mix(static_cast<std::uint64_t>(key));
+  } else {
+    static_assert(std::is_same<K, std::string_view>::value,
+                  "perfect_map keys must be integral, enum or string_view");
+    // FNV-1a
+    std::uint64_t h = 0xCBF29CE484222325ULL;
+    for (char c : key) {
+      h ^= static_cast<unsigned char>(c);
+      h *= 0x100000001B3ULL;
+    }
+    return perfect_mix(h);
+  }
+}
+
+constexpr std::size_t perfect_table_size(std::size_t n) noexcept {
+  std::size_t size = 1;
+  while (size < 2 * n) size *= 2;
+  return size;
+}
+
+}  // namespace detail
+
+//
+template <typename K, typename V, std::size_t N>
+class perfect_map {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<K, V>;
+  using const_iterator = const value_type*;
+
+ private:
+  static constexpr std::size_t num_slots = detail::perfect_table_size(N);
+  static constexpr std::size_t num_buckets = N / 2 + 1;
+  static constexpr std::uint32_t no_entry = static_cast<std::uint32_t>(N);
+  static constexpr std::uint32_t max_displacement = 1U << 24;
+
+  static_assert(N < 0xFFFFFFFFULL, "perfect_map has too many entries");
+
+  std::array<value_type, N> entries;
+  std::array<std::uint32_t, num_slots> slot_entry{};  // entry index
+  std::array<std::uint32_t, num_buckets> displacement{};
+
+  static constexpr std::size_t bucket_of(std::uint64_t h) noexcept {
+    return static_cast<std::size_t>((h >> 32) % num_buckets);
+  }
+
+  static constexpr std::size_t slot_of(std::uint64_t h,
+                                       std::uint32_t d) noexcept {
+    return static_cast<std::size_t>(
+        detail::perfect_mix(h + d * 0x9E3779B97F4A7C15ULL) &
+        (num_slots - 1));
+  }
+
+  template <std::size_t... I>
+  constexpr perfect_map(const value_type (&items)[N],
+                        std::index_sequence<I...>)
+      : entries{{items[I]...}} {
+    build();
+  }
+
+  constexpr void build() {
+    std::array<std::uint64_t, N> hashes{};
+    std::array<std::size_t, num_buckets + 1> start{};
+    std::array<std::size_t, N> order{};  // entries grouped by bucket
+    for (std::size_t i = 0; i < N; ++i) {
+      hashes[i] = detail::perfect_key_hash(entries[i].first);
+      ++start[bucket_of(hashes[i]) + 1];
+    }
+    for (std::size_t b = 0; b < num_buckets; ++b) start[b + 1] += start[b];
+    std::array<std::size_t, num_buckets> fill{};
+    for (std::size_t i = 0; i < N; ++i) {
+      std::size_t b = bucket_of(hashes[i]);
+      order[start[b] + fill[b]++] = i;
+    }
+    // buckets by decreasing size (insertion sort, done once)
+    std::array<std::size_t, num_buckets> buckets{};
+    for (std::size_t b = 0; b < num_buckets; ++b) {
+      std::size_t j = b;
+      for (; j > 0 && fill[buckets[j - 1]] < fill[b]; --j)
+        buckets[j] = buckets[j - 1];
+      buckets[j] = b;
+    }
+    for (std::size_t s = 0; s < num_slots; ++s) slot_entry[s] = no_entry;
+    for (std::size_t b : buckets) {
+      std::size_t first = start[b];
+      std::size_t last = start[b] + fill[b];
+      if (first == last) break;  // remaining buckets are empty
+      // equal keys always share a bucket
+      for (std::size_t k = first; k < last; ++k)
+        for (std::size_t p = first; p < k; ++p)
+          if (entries[order[p]].first == entries[order[k]].first)
+            throw std::invalid_argument("perfect_map: duplicate keys");
+      std::uint32_t d = 0;
+      for (;; ++d) {
+        if (d == max_displacement)  // only for full 64-bit hash collisions
+          throw std::invalid_argument("perfect_map: no perfect hash");
+        // all keys of bucket go to distinct free slots?
+        bool ok = true;
+        for (std::size_t k = first; ok && k < last; ++k) {
+          std::size_t s = slot_of(hashes[order[k]], d);
+          ok = slot_entry[s] == no_entry;
+          for (std::size_t p = first; ok && p < k; ++p)
+            ok = slot_of(hashes[order[p]], d) != s;
+        }
+        if (ok) break;
+      }
+      displacement[b] = d;
+      for (std::size_t k = first; k < last; ++k)
+        slot_entry[slot_of(hashes[order[k]], d)] =
+            static_cast<std::uint32_t>(order[k]);
+    }
+  }
+
+ public:
+  explicit constexpr perfect_map(const value_type (&items)[N])
+      : perfect_map{items, std::make_index_sequence<N>{}} {}
+
+  constexpr std::size_t size() const noexcept { return N; }
+
+  constexpr bool empty() const noexcept { return N == 0; }
+
+  // one hash, one key comparison
+  constexpr const_optional_view<V> lookup(const K& key) const noexcept {
+    std::uint64_t h = detail::perfect_key_hash(key);
+    std::uint32_t i = slot_entry[slot_of(h, displacement[bucket_of(h)])];
+    const V* value =
+        i != no_entry && entries[i].first == key ? &entries[i].second
+                                                 : nullptr;
+    return detail::view_access::make<const V>(value);
+  }
+
+  constexpr bool contains(const K& key) const noexcept {
+    return static_cast<bool>(lookup(key));
+  }
+
+  // entries, in construction order
+  constexpr const_iterator begin() const noexcept { return entries.data(); }
+
+  constexpr const_iterator end() const noexcept {
+    return entries.data() + N;
+  }
+};
+
+template <typename K, typename V, std::size_t N>
+constexpr perfect_map<K, V, N> make_perfect_map(
+    const std::pair<K, V> (&items)[N]) {
+  return perfect_map<K, V, N>{items};
+}
+
+}  // namespace opview
+
+#endif  // OPVIEW_PERFECT_MAP_HPP_
@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+#ifndef OPVIEW_SENTINEL_OPTIONAL_VIEW_HPP_
+#define OPVIEW_SENTINEL_OPTIONAL_VIEW_HPP_
+
+// Sentinel Optional View:
+// This is a read-only alternative to optional_view, for read-mostly data
+// (such as configs), where empty state does not store nullptr, but the
+// address of a per-type static default instance (a "null object").
+// So, operator* never needs a null check (empty just views the default),
+// and engagement is tested by comparing against the sentinel address.
+// Default instance can be customized by specializing opview::null_object<T>.
+
+#include <optional>     // for std::nullopt
+#include <type_traits>  // for std::is_trivially_copyable
+
+#include "optional_view.hpp"
+
+namespace opview {
+
+// per-type default instance, viewed by empty sentinel_optional_view<T>
+template <typename T>
+struct null_object {
+  static inline const T instance{};
+};
+
+//
+template <typename T>
+class sentinel_optional_view {  // NOLINT
+  using value_type = T;
+
+ private:
+  const T* value;  // never nullptr
+
+  static constexpr const T* sentinel() noexcept {
+    return &null_object<T>::instance;
+  }
+
+ public:
+  constexpr sentinel_optional_view() noexcept : value{sentinel()} {}
+
+  // this is unsafe: but the risk is yours! (explicit or implicit)
+  // NOLINTNEXTLINE
+  constexpr sentinel_optional_view(const T& _value) noexcept
+      : value{&_value} {}
+
+  // cannot support rvalue due to non-ownership semantics
+  // NOLINTNEXTLINE
+  sentinel_optional_view(const T&& _value) = delete;
+
+  // allow nullopt (explicit or implicit)
+  // NOLINTNEXTLINE
+  constexpr sentinel_optional_view(std::nullopt_t) noexcept
+      : value{sentinel()} {}
+
+  // disallow nullptr
+  // NOLINTNEXTLINE
+  sentinel_optional_view(std::nullptr_t data) = delete;
+
+  // allow optional<T> for compatibility (explicit or implicit)
+  // NOLINTNEXTLINE
+  constexpr sentinel_optional_view(const std::optional<T>& op_data) noexcept
+      : value{op_data ? &(*op_data) : sentinel()} {}
+
+  // cannot view a temporary optional (it would dangle)
+  // NOLINTNEXTLINE
+  sentinel_optional_view(const std::optional<T>&& op_data) = delete;
+
+  // allow optional_view (explicit or implicit)
+  template <class X, class XAccess,
+            typename = typename std::enable_if<
+                std::is_convertible<X*, const T*>::value>::type>
+  // NOLINTNEXTLINE
+  constexpr sentinel_optional_view(
+      const optional_view<X, XAccess>& other) noexcept
+      : value{other ? &other.value_unchecked() : sentinel()} {}
+
+  // ===============================================
+
+  constexpr sentinel_optional_view(
+      const sentinel_optional_view& other) noexcept = default;
+
+  ~sentinel_optional_view() = default;
+
+  // MUST delete all operator=
+  // This is coherent to *_view behavior, and also prevent misleading issues
+  // with possible rebind or not rebind... this is not needed on a view.
+  sentinel_optional_view& operator=(const sentinel_optional_view&) = delete;
+
+  sentinel_optional_view& operator=(sentinel_optional_view&&) = delete;
+
+  // return raw pointer (never nullptr)
+  constexpr const T* operator->() const noexcept { return value; }
+
+  // return dereferenced object (default instance, when empty)
+  constexpr const T& operator*() const noexcept { return *value; }
+
+  // return dereferenced object (default instance, when empty)
+  constexpr const T& get() const noexcept { return *value; }
+
+  // return dereferenced object (default instance, when empty)
+  constexpr operator const T&() const noexcept { return *value; }
+
+  constexpr bool empty() const noexcept { return value == sentinel(); }
+
+  // has some view? (explicit: operator const T& already converts)
+  constexpr explicit operator bool() const noexcept {
+    return value != sentinel();
+  }
+
+  // back to regular optional_view vocabulary
+  constexpr const_optional_view<T> view() const noexcept {
+    return empty() ? const_optional_view<T>{} : const_optional_view<T>{*value};
+  }
+};
+
+static_assert(sizeof(sentinel_optional_view<int>) == sizeof(int*),
+              "sentinel_optional_view<T> must have the same size as T*");
+static_assert(std::is_trivially_copyable<sentinel_optional_view<int>>::value,
+              "sentinel_optional_view<T> must be trivially copyable");
+
+}  // namespace opview
+
+#endif  // OPVIEW_SENTINEL_OPTIONAL_VIEW_HPP_
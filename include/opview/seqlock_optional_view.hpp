@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+#ifndef OPVIEW_SEQLOCK_OPTIONAL_VIEW_HPP_
+#define OPVIEW_SEQLOCK_OPTIONAL_VIEW_HPP_
+
+// Seqlock Optional View:
+// a slot holding an optional T (empty or engaged), for state that is
+// written rarely and read very often by many threads.
+// Writers bump a sequence counter (odd while writing), readers copy the
+// data and retry if the sequence changed meanwhile. So, readers never
+// write to shared memory (no cache line ping-pong among cores), and always
+// get a consistent snapshot:
+// - load(): copy as std::optional<T>
+// - read(f): calls f(const_optional_view<T>) on a consistent local copy
+//   (no std::optional is materialized), and returns what f returns
+// Data is kept as relaxed atomic words, so concurrent copies are not data
+// races; T must be trivially copyable. Writers may be concurrent (they
+// serialize on the sequence counter), but they should be rare.
+
+#include <atomic>       // for std::atomic
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint64_t
+#include <cstring>      // for std::memcpy
+#include <new>          // for std::launder
+#include <optional>     // for std::optional
+#include <thread>       // for std::this_thread::yield
+#include <type_traits>  // for std::is_trivially_copyable
+#include <utility>      // for std::forward
+
+#include "optional_view.hpp"
+
+namespace opview {
+//
+template <typename T>
+class alignas(64) seqlock_optional_view {  // NOLINT
+  static_assert(std::is_trivially_copyable<T>::value,
+                "seqlock_optional_view<T> requires trivially copyable T");
+
+  using value_type = T;
+
+ private:
+  static constexpr std::size_t num_words =
+      (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+  // local (non-shared) copy of a snapshot
+  struct snapshot {
+    alignas(T) unsigned char bytes[num_words * sizeof(std::uint64_t)];
+    bool engaged;
+
+    const T& value() const noexcept {
+      return *std::launder(reinterpret_cast<const T*>(bytes));
+    }
+  };
+
+  std::atomic<std::uint64_t> sequence{0};  // odd: write in progress
+  std::atomic<bool> engaged{false};
+  std::atomic<std::uint64_t> words[num_words]{};
+
+  // enters write section (serializes concurrent writers)
+  std::uint64_t begin_write() noexcept {
+    std::uint64_t seq = sequence.load(std::memory_order_relaxed);
+    for (;;) {
+      if ((seq & 1U) == 0 &&
+          sequence.compare_exchange_weak(seq, seq + 1,
+                                         std::memory_order_acquire,
+                                         std::memory_order_relaxed))
+        break;
+      std::this_thread::yield();
+      seq = sequence.load(std::memory_order_relaxed);
+    }
+    // data stores must not become visible before odd sequence
+    std::atomic_thread_fence(std::memory_order_release);
+    return seq;
+  }
+
+  void end_write(std::uint64_t seq) noexcept {
+    sequence.store(seq + 2, std::memory_order_release);
+  }
+
+  // consistent copy (retries while a writer is active)
+  snapshot read_snapshot() const noexcept {
+    snapshot snap;
+    for (;;) {
+      std::uint64_t seq1 = sequence.load(std::memory_order_acquire);
+      if (seq1 & 1U) continue;
+      for (std::size_t i = 0; i < num_words; ++i) {
+        std::uint64_t w = words[i].load(std::memory_order_relaxed);
+        std::memcpy(snap.bytes + i * sizeof(w), &w, sizeof(w));
+      }
+      snap.engaged = engaged.load(std::memory_order_relaxed);
+      // data loads must complete before sequence is checked again
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence.load(std::memory_order_relaxed) == seq1) return snap;
+    }
+  }
+
+ public:
+  seqlock_optional_view() noexcept = default;
+
+  explicit seqlock_optional_view(const T& value) noexcept { store(value); }
+
+  seqlock_optional_view(const seqlock_optional_view&) = delete;
+
+  seqlock_optional_view& operator=(const seqlock_optional_view&) = delete;
+
+  // ===============================================
+  // writer side
+
+  void store(const T& value) noexcept {
+    std::uint64_t seq = begin_write();
+    unsigned char bytes[num_words * sizeof(std::uint64_t)] = {};
+    std::memcpy(bytes, &value, sizeof(T));
+    for (std::size_t i = 0; i < num_words; ++i) {
+      std::uint64_t w;
+      std::memcpy(&w, bytes + i * sizeof(w), sizeof(w));
+      words[i].store(w, std::memory_order_relaxed);
+    }
+    engaged.store(true, std::memory_order_relaxed);
+    end_write(seq);
+  }
+
+  void reset() noexcept {
+    std::uint64_t seq = begin_write();
+    engaged.store(false, std::memory_order_relaxed);
+    end_write(seq);
+  }
+
+  // ===============================================
+  // reader side (no writes to shared memory)
+
+  std::optional<T> load() const noexcept {
+    snapshot snap = read_snapshot();
+    return snap.engaged ? std::optional<T>{snap.value()} : std::nullopt;
+  }
+
+  // f receives a const_optional_view<T> to a consistent local copy
+  template <typename F>
+  decltype(auto) read(F&& f) const {
+    snapshot snap = read_snapshot();
+    return std::forward<F>(f)(snap.engaged
+                                  ? const_optional_view<T>{snap.value()}
+                                  : const_optional_view<T>{});
+  }
+
+  // has some value? (only a hint, as it may change right after)
+  bool empty() const noexcept {
+    return !engaged.load(std::memory_order_acquire);
+  }
+};
+
+}  // namespace opview
+
+#endif  // OPVIEW_SEQLOCK_OPTIONAL_VIEW_HPP_
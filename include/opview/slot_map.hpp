@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+#ifndef OPVIEW_SLOT_MAP_HPP_
+#define OPVIEW_SLOT_MAP_HPP_
+
+// Slot Map:
+// a container of T addressed by handles (index + generation), where
+// find(handle) gives optional_view<T>: stale handles (erased objects)
+// resolve to empty in O(1), with no hashing, instead of dangling.
+// Values are kept dense (contiguous, in no particular order), so iteration
+// over live objects is cache-friendly; erased slots go to a free list and
+// their generation is bumped, invalidating all old handles.
+// Note: as in std::vector, views from find() are invalidated by insertion
+// and erasure (handles are not).
+
+#include <cstddef>   // for std::size_t
+#include <cstdint>   // for std::uint32_t
+#include <limits>    // for std::numeric_limits
+#include <utility>   // for std::move, std::forward
+#include <vector>    // for std::vector
+
+#include "optional_view.hpp"
+
+namespace opview {
+
+// stable reference to an object in a slot_map
+struct slot_handle {
+  std::uint32_t index{std::numeric_limits<std::uint32_t>::max()};
+  std::uint32_t generation{0};
+
+  friend constexpr bool operator==(const slot_handle& a,
+                                   const slot_handle& b) noexcept {
+    return a.index == b.index && a.generation == b.generation;
+  }
+
+  friend constexpr bool operator!=(const slot_handle& a,
+                                   const slot_handle& b) noexcept {
+    return !(a == b);
+  }
+};
+
+//
+template <typename T>
+class slot_map {
+ public:
+  using value_type = T;
+  using handle = slot_handle;
+  using iterator = typename std::vector<T>::iterator;
+  using const_iterator = typename std::vector<T>::const_iterator;
+
+ private:
+  static constexpr std::uint32_t npos =
+      std::numeric_limits<std::uint32_t>::max();
+
+  struct slot {
+    std::uint32_t target;  // dense index when live, next free slot otherwise
+    std::uint32_t generation;
+  };
+
+  std::vector<T> values;                // dense storage
+  std::vector<std::uint32_t> owners;    // dense index -> slot index
+  std::vector<slot> slots;              // handle index -> dense index
+  std::uint32_t free_head{npos};        // first free slot
+
+  // room for one more push_back (keeping geometric growth)
+  template <typename Vector>
+  static void reserve_one(Vector& v) {
+    if (v.size() == v.capacity()) v.reserve(v.empty() ? 8 : 2 * v.size());
+  }
+
+  // address of live object, or nullptr for stale/invalid handles
+  const T* lookup(handle h) const noexcept {
+    if (h.index >= slots.size()) return nullptr;
+    const slot& s = slots[h.index];
+    return s.generation == h.generation ? values.data() + s.target : nullptr;
+  }
+
+ public:
+  slot_map() = default;
+
+  std::size_t size() const noexcept { return values.size(); }
+
+  bool empty() const noexcept { return values.empty(); }
+
+  void reserve(std::size_t n) {
+    values.reserve(n);
+    owners.reserve(n);
+    slots.reserve(n);
+  }
+
+  template <typename... Args>
+  handle emplace(Args&&... args) {
+    // bookkeeping grows first: once the value exists, nothing else throws
+    reserve_one(owners);
+    if (free_head == npos) reserve_one(slots);
+    auto dense = static_cast<std::uint32_t>(values.size());
+    values.emplace_back(std::forward<Args>(args)...);
+    std::uint32_t index = free_head;
+    if (index != npos) {
+      free_head = slots[index].target;
+      slots[index].target = dense;
+    } else {
+      index = static_cast<std::uint32_t>(slots.size());
+      slots.push_back(slot{dense, 0});
+    }
+    owners.push_back(index);
+    return handle{index, slots[index].generation};
+  }
+
+  handle insert(const T& value) { return emplace(value); }
+
+  handle insert(T&& value) { return emplace(std::move(value)); }
+
+  // erases object (last one is moved into its place); returns false for
+  // stale handles
+  bool erase(handle h) {
+    if (!lookup(h)) return false;
+    slot& s = slots[h.index];
+    std::uint32_t dense = s.target;
+    std::uint32_t last = static_cast<std::uint32_t>(values.size()) - 1;
+    if (dense != last) {
+      values[dense] = std::move(values[last]);
+      owners[dense] = owners[last];
+      slots[owners[dense]].target = dense;
+    }
+    values.pop_back();
+    owners.pop_back();
+    ++s.generation;  // invalidates all handles to this slot
+    s.target = free_head;
+    free_head = h.index;
+    return true;
+  }
+
+  void clear() {
+    for (std::uint32_t dense = 0; dense < owners.size(); ++dense) {
+      slot& s = slots[owners[dense]];
+      ++s.generation;
+      s.target = free_head;
+      free_head = owners[dense];
+    }
+    values.clear();
+    owners.clear();
+  }
+
+  // live object, or empty for stale/invalid handles
+  optional_view<T> find(handle h) noexcept {
+    return detail::view_access::make<T>(const_cast<T*>(lookup(h)));
+  }
+
+  const_optional_view<T> find(handle h) const noexcept {
+    return detail::view_access::make<const T>(lookup(h));
+  }
+
+  bool contains(handle h) const noexcept { return lookup(h) != nullptr; }
+
+  // dense iteration over live objects (unspecified order)
+  iterator begin() noexcept { return values.begin(); }
+
+  iterator end() noexcept { return values.end(); }
+
+  const_iterator begin() const noexcept { return values.begin(); }
+
+  const_iterator end() const noexcept { return values.end(); }
+
+  T* data() noexcept { return values.data(); }
+
+  const T* data() const noexcept { return values.data(); }
+};
+
+}  // namespace opview
+
+#endif  // OPVIEW_SLOT_MAP_HPP_
@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2023 - optional_view
+// https://github.com/igormcoelho/optional_view
+
+#ifndef OPVIEW_STORABLE_OPTIONAL_VIEW_HPP_
+#define OPVIEW_STORABLE_OPTIONAL_VIEW_HPP_
+
+// Storable Optional View:
+// This is an opt-in version of optional_view, to be kept in containers
+// (std::vector, flat maps, ring buffers, ...), where copy/move assignment
+// are required. So, differently from optional_view, it can be rebound
+// (assigned) to another reference, or reset().
+// It is trivially copyable (so, trivially relocatable), with the same
+// layout as T*, and converts implicitly back to optional_view<T>, which is
+// still the one to be used for parameter passing (no rebind).
+
+#include <optional>     // for std::nullopt
+#include <type_traits>  // for std::is_trivially_copyable
+
+#include "optional_view.hpp"
+
+namespace opview {
+//
+template <typename T, typename Access = unchecked_access>
+class storable_optional_view {  // NOLINT
+  using value_type = T;
+
+ private:
+  T* value{nullptr};
+
+ public:
+  constexpr storable_optional_view() noexcept = default;
+
+  // this is unsafe: but the risk is yours! (explicit or implicit)
+  // NOLINTNEXTLINE
+  constexpr storable_optional_view(T& _value) noexcept : value{&_value} {}
+
+  // cannot support rvalue due to non-ownership semantics
+  // NOLINTNEXTLINE
+  storable_optional_view(T&& _value) = delete;
+
+  // allow nullopt (explicit or implicit)
+  // NOLINTNEXTLINE
+  constexpr storable_optional_view(std::nullopt_t) noexcept {}
+
+  // disallow nullptr
+  // NOLINTNEXTLINE
+  storable_optional_view(std::nullptr_t data) = delete;
+
+  // allow optional<T> for compatibility (explicit or implicit)
+  // NOLINTNEXTLINE
+  constexpr storable_optional_view(std::optional<T>& op_data) noexcept
+      : value{op_data ? &(*op_data) : nullptr} {}
+
+  // allow optional_view (explicit or implicit)
+  template <class X, class XAccess,
+            typename = typename std::enable_if<
+                std::is_convertible<X*, T*>::value>::type>
+  // NOLINTNEXTLINE
+  constexpr storable_optional_view(
+      const optional_view<X, XAccess>& other) noexcept
+      : value{detail::view_access::pointer(other)} {}
+
+  // ===============================================
+  // copy, move and assignment: all trivial (rebinds the view)
+
+  constexpr storable_optional_view(const storable_optional_view&) noexcept =
+      default;
+
+  constexpr storable_optional_view(storable_optional_view&&) noexcept =
+      default;
+
+  constexpr storable_optional_view& operator=(
+      const storable_optional_view&) noexcept = default;
+
+  constexpr storable_optional_view& operator=(
+      storable_optional_view&&) noexcept = default;
+
+  ~storable_optional_view() = default;
+
+  // back to (non-rebindable) optional_view, for parameter passing
+  constexpr optional_view<T, Access> view() noexcept {
+    return detail::view_access::make<T, Access>(value);
+  }
+
+  constexpr const_optional_view<T, Access> view() const noexcept {
+    return detail::view_access::make<const T, Access>(value);
+  }
+
+  // NOLINTNEXTLINE
+  constexpr operator optional_view<T, Access>() noexcept { return view(); }
+
+  // NOLINTNEXTLINE
+  constexpr operator const_optional_view<T, Access>() const noexcept {
+    return view();
+  }
+
+  // return raw pointer
+  constexpr T* operator->() noexcept(Access::nothrow) {
+    Access::check(value != nullptr);
+    return value;
+  }
+
+  // return raw pointer
+  constexpr const T* operator->() const noexcept(Access::nothrow) {
+    Access::check(value != nullptr);
+    return value;
+  }
+
+  // return dereferenced object
+  constexpr T& operator*() noexcept(Access::nothrow) {
+    Access::check(value != nullptr);
+    return *value;
+  }
+
+  // return dereferenced object
+  constexpr const T& operator*() const noexcept(Access::nothrow) {
+    Access::check(value != nullptr);
+    return *value;
+  }
+
+  // return dereferenced object
+  constexpr T& get() noexcept(Access::nothrow) { return **this; }
+
+  // return dereferenced object
+  constexpr const T& get() const noexcept(Access::nothrow) { return **this; }
+
+  // copy of viewed value, or default (selects address, dereferences once)
+  constexpr std::remove_cv_t<T> value_or(const T& _default) const
+      noexcept(std::is_nothrow_copy_constructible<T>::value) {
+    return *(value ? value : &_default);
+  }
+
+  constexpr bool empty() const noexcept { return !(value); }
+
+  // has some view? (explicit: never converts to integers)
+  constexpr explicit operator bool() const noexcept { return (bool)value; }
+
+  constexpr void reset() noexcept { value = nullptr; }
+
+  // hints the CPU to bring viewed data into cache (no-op when empty)
+  void prefetch() const noexcept {
+    if (value) OPVIEW_PREFETCH(value);
+  }
+
+  // same referenced object (or both empty)?
+  friend constexpr bool operator==(const storable_optional_view& a,
+                                   const storable_optional_view& b) noexcept {
+    return a.value == b.value;
+  }
+
+  friend constexpr bool operator!=(const storable_optional_view& a,
+                                   const storable_optional_view& b) noexcept {
+    return a.value != b.value;
+  }
+};
+
+// same layout as T*, and relocatable by plain memcpy (as in a vector)
+static_assert(sizeof(storable_optional_view<int>) == sizeof(int*),
+              "storable_optional_view<T> must have the same size as T*");
+static_assert(std::is_trivially_copyable<storable_optional_view<int>>::value,
+              "storable_optional_view<T> must be trivially copyable");
+static_assert(
+    std::is_trivially_copy_assignable<storable_optional_view<int>>::value,
+    "storable_optional_view<T> must be trivially assignable");
+
+}  // namespace opview
+
+#endif  // OPVIEW_STORABLE_OPTIONAL_VIEW_HPP_